@@ -57,6 +57,23 @@ void CActionBubble::ModelUpdated()
     m_actionsView->setText(txt);
     AdjustMinSize();
     UpdatePolygon();
+
+    emit LabelsChanged();
+    emit TextChanged();
+}
+
+QStringList CActionBubble::labels() const
+{
+    QStringList lst = CSingleLinkBubble::labels();
+
+    for(const QString &action : m_actions->stringList())
+    {
+        QStringList words = action.split(" ", QString::SkipEmptyParts);
+        if(words.length() > 1 && words[0] == "*label")
+            lst.append(words[1]);
+    }
+
+    return lst;
 }
 
 void CActionBubble::setPalette(CPaletteAction *palette)
@@ -23,6 +23,8 @@ public:
 
     QString actionString();
 
+    virtual QStringList labels() const override;
+
 protected:
     virtual void UpdatePolygon() override;
 
@@ -24,10 +24,11 @@ using Chronicler::shared;
 
 
 QList<t_uid> CBubble::m_UIDs = QList<t_uid>();
+t_uid CBubble::m_nextUID = 1;
 
 CBubble::CBubble(const QPointF &pos, CPaletteAction *palette, const QFont &font, QGraphicsItem *parent)
     : QGraphicsPolygonItem(parent),
-      m_minSize(QSizeF(150, 100)), m_order(0), m_locked(false),
+      m_UID(0), m_minSize(QSizeF(150, 100)), m_order(0), m_locked(false),
       m_font(font), m_paletteAction(palette), m_resize(false)
 {
     setFlag(QGraphicsItem::ItemIsMovable, true);
@@ -155,14 +156,26 @@ void CBubble::AddUID(t_uid uid)
         m_UIDs.append(uid);
 }
 
+/**
+ * @brief Gives this bubble the next UID of the project, bubbles start without one
+ *        and only get it here when they are new, read bubbles keep their own.
+ */
 void CBubble::UpdateUID()
 {
     m_UID = GenerateUID();
+
+    for(CConnection *c : connections() + links())
+        if(c)
+            c->UpdateUIDs();
 }
 
-t_uid CBubble::GenerateUID() const
+/**
+ * @brief The next UID of the open project, UIDs are handed out in order
+ *        and saved with the project so unchanged bubbles save the same.
+ */
+t_uid CBubble::GenerateUID()
 {
-    return reinterpret_cast<t_uid>(this);
+    return m_nextUID++;
 }
 
 Anchor CBubble::AnchorAtPosition(const QPointF &pos)
@@ -187,6 +200,20 @@ void CBubble::UpdatePalette()
 }
 
 
+void CBubble::setLabel(QString label)
+{
+    m_label = label;
+    emit LabelsChanged();
+}
+
+QStringList CBubble::labels() const
+{
+    if(m_label.isEmpty())
+        return QStringList();
+
+    return QStringList(m_label);
+}
+
 void CBubble::setFont(const QFont &font)
 {
     if(font != m_font)
@@ -263,7 +290,7 @@ Anchor CBubble::InputAnchorAtPosition(const QPointF &pos)
     return AnchorAtPosition(pos);
 }
 
-t_uid CBubble::getUID()
+t_uid CBubble::getUID() const
 {
     return m_UID;
 }
@@ -296,7 +323,10 @@ QDataStream &CBubble::Deserialize(QDataStream &ds, const Chronicler::CVersion &v
                 >> palette_uid
                 >> m_bounds >> pos;
 
-        m_paletteAction = shared().paletteButton->getPaletteWithUID(palette_uid);
+        // keep the default palette when pasting from a project without this one
+        CPaletteAction *palette = shared().paletteButton->getPaletteWithUID(palette_uid);
+        if(palette)
+            m_paletteAction = palette;
     }
 
     setLabel(m_label);
@@ -309,7 +339,7 @@ QDataStream &CBubble::Deserialize(QDataStream &ds, const Chronicler::CVersion &v
 QDataStream & CBubble::Serialize(QDataStream &ds) const
 {
     ds << static_cast<qint32>(m_type)
-       << GenerateUID()
+       << m_UID
        << m_label << m_order << m_locked
        << m_paletteAction->getUID()
        << m_bounds << scenePos();
@@ -6,6 +6,7 @@
 #include <QGraphicsPolygonItem>
 
 #include <QFont>
+#include <QStringList>
 
 QT_BEGIN_NAMESPACE
 class QGraphicsItem;
@@ -36,9 +37,12 @@ public:
 
     virtual ~CBubble();
 
-    virtual void setLabel(QString label) { m_label = label; }
+    virtual void setLabel(QString label);
     QString getLabel() const { return m_label; }
 
+    /// @brief every label defined by this bubble, including the ones in its contents
+    virtual QStringList labels() const;
+
     void setOrder(qint64 order) { m_order = order; }
     qint64 getOrder() const { return m_order; }
 
@@ -72,9 +76,12 @@ public:
     virtual Anchor OutputAnchorAtPosition(const QPointF &pos);
     virtual Anchor InputAnchorAtPosition(const QPointF &pos);
 
-    t_uid getUID();
+    t_uid getUID() const;
     virtual void UpdateUID();
-    t_uid GenerateUID() const;
+    static t_uid GenerateUID();
+
+    static t_uid nextUID() { return m_nextUID; }
+    static void setNextUID(t_uid uid) { m_nextUID = uid; }
 
 
 
@@ -123,6 +130,9 @@ private:
 
     // for backwards compatability
     static QList<t_uid> m_UIDs;
+
+    // next UID of the open project, saved with it
+    static t_uid m_nextUID;
     
 signals:
     void Selected(QGraphicsItem *item);
@@ -132,6 +142,8 @@ signals:
     void ShapeChanged(const QRectF &oldRect, const QRectF &newRect);
 
     void PaletteChanged();
+    void LabelsChanged();
+    void TextChanged();
 
 private slots:
     void UpdatePalette();
@@ -154,7 +154,7 @@ QDataStream & CChoice::Deserialize(QDataStream &ds, const Chronicler::CVersion &
 
 QDataStream & CChoice::Serialize(QDataStream &ds) const
 {
-    ds << GenerateUID() << m_choice->Text() << bool(m_link);
+    ds << m_UID << m_choice->Text() << bool(m_link);
 
     if(m_link)
         ds << *m_link;
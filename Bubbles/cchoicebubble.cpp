@@ -42,6 +42,8 @@ void CChoiceBubble::setPalette(CPaletteAction *palette)
 void CChoiceBubble::setFont(const QFont &font)
 {
     CBubble::setFont(font);
+    for(CChoice *choice : m_choices->choices())
+        choice->setFont(font);
     AdjustMinSize();
     UpdatePolygon();
 }
@@ -112,6 +114,7 @@ void CChoiceBubble::ModelUpdated()
     AdjustMinSize();
     UpdatePolygon();
     emit PositionOrShapeChanged();
+    emit TextChanged();
 }
 
 
@@ -32,6 +32,7 @@ void CCodeBubble::setPalette(CPaletteAction *palette)
 void CCodeBubble::setCode(const QString &code)
 {
     m_code->setText(code);
+    emit TextChanged();
 }
 
 QString CCodeBubble::getCode() const
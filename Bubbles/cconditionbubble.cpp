@@ -69,6 +69,8 @@ void CConditionBubble::setCondition(QString condition)
     m_condition->setText(txt);
     AdjustMinSize();
     UpdatePolygon();
+
+    emit TextChanged();
 }
 
 void CConditionBubble::RemoveLink(CConnection *link)
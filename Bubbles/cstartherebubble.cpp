@@ -10,6 +10,10 @@ CStartHereBubble::CStartHereBubble(const QPointF &pos, CPaletteAction *palette,
     m_type = Chronicler::StartHereBubble;
 
     m_model = new CStartHereModel(this);
+    connect(m_model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)), this, SIGNAL(TextChanged()));
+    connect(m_model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SIGNAL(TextChanged()));
+    connect(m_model, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SIGNAL(TextChanged()));
+    connect(m_model, SIGNAL(modelReset()), this, SIGNAL(TextChanged()));
 
     m_title = new CTextItem("", m_bounds, this);
     m_title->SetStyle(Qt::AlignCenter);
@@ -26,7 +30,7 @@ QDataStream &CStartHereBubble::Deserialize(QDataStream &ds, const Chronicler::CV
 {
     CSingleLinkBubble::Deserialize(ds, version);
 
-    QList<CVariable> modelData;
+    QVector<CVariable> modelData;
     ds >> modelData;
 
     m_model->setVariables(modelData);
@@ -68,6 +72,7 @@ QString CStartHereBubble::customCode() const
 void CStartHereBubble::setCustomCode(const QString &customCode)
 {
     m_customCode = customCode;
+    emit TextChanged();
 }
 
 
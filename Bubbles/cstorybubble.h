@@ -23,7 +23,7 @@ public:
 
     virtual void setLabel(QString label);
 
-    void setStory(QString story) { m_story->setText(story); }
+    void setStory(QString story) { m_story->setText(story); emit TextChanged(); }
     QString getStory() const { return m_story->Text(); }
 
 protected:
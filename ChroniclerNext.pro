@@ -111,7 +111,17 @@ HEADERS += \
     hunspell/suggestmgr.hxx \
     hunspell/w_char.hxx \
     Misc/SpellTextEdit.h \
-    Misc/highlighter.h
+    Misc/highlighter.h \
+    cminimap.h \
+    Misc/cdictionary.h \
+    Misc/cspellchecker.h \
+    Misc/cslexer.h \
+    Misc/ccompletionindex.h \
+    Misc/ccompletionmodel.h \
+    Misc/Variables/csymboltable.h \
+    Properties/cusagesview.h \
+    Misc/History/chistorycommand.h \
+    Misc/History/ceditbubblecommand.h
 
 SOURCES += \
     Bubbles/cactionbubble.cpp \
@@ -199,7 +209,17 @@ SOURCES += \
     hunspell/suggestmgr.cxx \
     hunspell/utf_info.cxx \
     Misc/SpellTextEdit.cpp \
-    Misc/highlighter.cpp
+    Misc/highlighter.cpp \
+    cminimap.cpp \
+    Misc/cdictionary.cpp \
+    Misc/cspellchecker.cpp \
+    Misc/cslexer.cpp \
+    Misc/ccompletionindex.cpp \
+    Misc/ccompletionmodel.cpp \
+    Misc/Variables/csymboltable.cpp \
+    Properties/cusagesview.cpp \
+    Misc/History/chistorycommand.cpp \
+    Misc/History/ceditbubblecommand.cpp
 
 DISTFILES += \
     hunspell/license.hunspell \
@@ -53,6 +53,7 @@ void CConnection::setFrom(CBubble *from)
     m_from = from;
     if(m_from)
     {
+        m_fromUID = m_from->getUID();
         m_from->AddLink(this);
         connect(m_from, SIGNAL(PositionOrShapeChanged()), this, SLOT(UpdatePosition()));
         connect(m_from, SIGNAL(PaletteChanged()), this, SLOT(FromPaletteChanged()));
@@ -79,6 +80,7 @@ void CConnection::setTo(CBubble *to)
     m_to = to;
     if(m_to)
     {
+        m_toUID = m_to->getUID();
         m_to->AddConnection(this);
         connect(m_to, SIGNAL(PositionOrShapeChanged()), this, SLOT(UpdatePosition()));
     }
@@ -145,26 +147,16 @@ void CConnection::setEndAnchor(Chronicler::Anchor anchor)
 }
 
 /**
- * @brief Connects this object with the two bubbles containing the
- *        UID's read during deserialization
- *
- *        To be called only after all bubbles have been instantiated
+ * @brief Connects this object with the two bubbles in the given table with the
+ *        UID's read during deserialization, the connection is removed if either is missing
  */
-void CConnection::ConnectToUIDs(bool paste)
+void CConnection::ConnectToUIDs(const QHash<t_uid, CBubble *> &bubbles)
 {
-    CBubble *from, *to;
-
-    if(paste)
-    {
-        from = shared().projectView->BubbleWithUID(m_fromUID, m_line->scene());
-        to = shared().projectView->BubbleWithUID(m_toUID, m_line->scene());
-    }
-    else
-    {
-        from = shared().projectView->BubbleWithUID(m_fromUID);
-        to = shared().projectView->BubbleWithUID(m_toUID);
-    }
+    Connect(bubbles.value(m_fromUID, Q_NULLPTR), bubbles.value(m_toUID, Q_NULLPTR));
+}
 
+void CConnection::Connect(CBubble *from, CBubble *to)
+{
     if(from && to)
     {
         setFrom(from);
@@ -183,6 +175,38 @@ void CConnection::ConnectToUIDs(bool paste)
     }
 }
 
+/**
+ * @brief Points this connection at bubbles that were recreated in place of deleted ones,
+ *        found by the UID's of the bubbles it was connected to.
+ *        The deleted bubbles are never touched, links are left as they are.
+ */
+void CConnection::ReplaceBubbles(const QHash<t_uid, CBubble *> &bubbles)
+{
+    if(CBubble *from = bubbles.value(m_fromUID))
+    {
+        m_from = from;
+        connect(m_from, SIGNAL(PositionOrShapeChanged()), this, SLOT(UpdatePosition()));
+        connect(m_from, SIGNAL(PaletteChanged()), this, SLOT(FromPaletteChanged()));
+    }
+
+    if(CBubble *to = bubbles.value(m_toUID))
+    {
+        m_to = to;
+        connect(m_to, SIGNAL(PositionOrShapeChanged()), this, SLOT(UpdatePosition()));
+    }
+}
+
+/**
+ * @brief Takes the current UID's of both ends, after either was renumbered.
+ */
+void CConnection::UpdateUIDs()
+{
+    if(m_from)
+        m_fromUID = m_from->getUID();
+    if(m_to)
+        m_toUID = m_to->getUID();
+}
+
 /**
  * @brief Deserializes this object in the format specified by version
  * @param stream The QDataStream to extract the data from
@@ -216,8 +240,8 @@ QDataStream & CConnection::Serialize(QDataStream &stream) const
 {
     stream << static_cast<qint32>(m_line->startAnchor())
            << static_cast<qint32>(m_line->endAnchor())
-           << m_from->GenerateUID()
-           << m_to->GenerateUID();
+           << m_from->getUID()
+           << m_to->getUID();
 
     return stream;
 }
@@ -3,6 +3,7 @@
 
 #include <QObject>
 #include <QGraphicsItem>
+#include <QHash>
 
 QT_BEGIN_NAMESPACE
 class QColor;
@@ -46,7 +47,9 @@ public:
     Anchor endAnchor() const;
     void setEndAnchor(Anchor anchor);
 
-    void ConnectToUIDs(bool paste = false);
+    void ConnectToUIDs(const QHash<t_uid, CBubble *> &bubbles);
+    void ReplaceBubbles(const QHash<t_uid, CBubble *> &bubbles);
+    void UpdateUIDs();
 
     bool isConnected() const;
 
@@ -57,6 +60,8 @@ protected:
     virtual QDataStream &Serialize(QDataStream &stream) const override;
 
 private:
+    void Connect(CBubble *from, CBubble *to);
+
     CBubble *m_from;
     CBubble *m_to;
 
@@ -9,14 +9,14 @@
 #include "Misc/Palette/cpaletteaction.h"
 
 CLine::CLine(const QPointF &start, const QPointF &end, Anchor anc_start, Anchor anc_end, QObject *parent)
-    : QObject(parent), QGraphicsItem(), m_start(start), m_end(end),
+    : QObject(parent), QGraphicsItem(), m_dirty(true), m_start(start), m_end(end),
       m_startAnchor(anc_start), m_endAnchor(anc_end), m_width(5)
 {
     UpdateShape();
 }
 
 CLine::CLine(const CLine &copy)
-    : QObject(copy.parent()), QGraphicsItem(), m_path(copy.m_path), m_width(copy.m_width)
+    : QObject(copy.parent()), QGraphicsItem(), m_path(copy.m_path), m_dirty(true), m_width(copy.m_width)
 {
     UpdateShape();
 }
@@ -30,14 +30,15 @@ CLine &CLine::operator=(const CLine &rhs)
 
 QPainterPath CLine::shape() const
 {
+    if(m_dirty)
+        BuildPath();
+
     return m_path;
 }
 
 QRectF CLine::boundingRect() const
 {
-    QRectF bounds(m_path.boundingRect());
-
-    return bounds;
+    return m_bounds;
 }
 
 CPaletteAction *CLine::getPalette()
@@ -65,6 +66,12 @@ void CLine::setEnd(const QPointF &end)
 
 void CLine::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *)
 {
+    // only called for lines that intersect an exposed region of a view
+    if(m_dirty)
+        BuildPath();
+
+    // the views don't save the painter state between items
+    painter->setBrush(Qt::NoBrush);
     painter->setPen(QPen(QBrush(m_palette->getPalette().line), m_width));
     painter->drawPath(m_path);
     painter->setPen(QPen(QBrush(m_palette->getPalette().fill), m_width/2));
@@ -79,24 +86,56 @@ void CLine::UpdateShape()
 {
     prepareGeometryChange();
 
-    m_path = QPainterPath();
+    m_dirty = true;
+    UpdateBounds();
 
+    update();
+}
+
+void CLine::UpdateBounds()
+{
+    // a cubic curve always lies inside the hull of its control points,
+    // so the bounds can be estimated without building the path
+    QPointF p1, p2;
+    ControlPoints(p1, p2);
+
+    const qreal left = qMin(qMin(m_start.x(), m_end.x()), qMin(p1.x(), p2.x()));
+    const qreal right = qMax(qMax(m_start.x(), m_end.x()), qMax(p1.x(), p2.x()));
+    const qreal top = qMin(qMin(m_start.y(), m_end.y()), qMin(p1.y(), p2.y()));
+    const qreal bottom = qMax(qMax(m_start.y(), m_end.y()), qMax(p1.y(), p2.y()));
+
+    // room for the arrow head and the pen
+    const qreal margin = 15 + m_width;
+    m_bounds = QRectF(QPointF(left, top), QPointF(right, bottom)).adjusted(-margin, -margin, margin, margin);
+}
+
+void CLine::ControlPoints(QPointF &p1, QPointF &p2) const
+{
     qreal start_angle = (qreal(m_startAnchor) * M_PI * 0.5);
     qreal end_angle = (qreal(m_endAnchor) * M_PI * 0.5);
 
-    QPointF p1(m_start.x(), m_start.y());
-    QPointF p2(m_end.x(), m_end.y());
+    p1 = m_start;
+    p2 = m_end;
     const qreal offset_x = qMax(qAbs(p2.x() - p1.x()) * 0.75, 65.0);
     const qreal offset_y = qMax(qAbs(p2.y() - p1.y()) * 0.75, 65.0);
     p1.rx() += (qRound(qCos(start_angle)) * offset_x);
     p1.ry() += (qRound(qSin(start_angle)) * offset_y);
     p2.rx() += (qRound(qCos(end_angle)) * offset_x);
     p2.ry() += (qRound(qSin(end_angle)) * offset_y);
+}
+
+void CLine::BuildPath() const
+{
+    m_path = QPainterPath();
+
+    QPointF p1, p2;
+    ControlPoints(p1, p2);
 
     m_path.moveTo(m_start);
     m_path.cubicTo(p1, p2, m_end);
 
     // create and rotate arrow
+    const qreal end_angle = (qreal(m_endAnchor) * M_PI * 0.5);
     const qreal size = 15;
     QRectF box(-size * 0.5, -size * 0.5, size, size);
     m_arrow = QPainterPath();
@@ -114,7 +153,7 @@ void CLine::UpdateShape()
 
     m_path.addPath(m_arrow);
 
-    update();
+    m_dirty = false;
 }
 
 Anchor CLine::endAnchor() const
@@ -53,9 +53,15 @@ public slots:
 
 private:
     void UpdateShape();
-
-    QPainterPath    m_path;
-    QPainterPath    m_arrow;
+    void UpdateBounds();
+    void ControlPoints(QPointF &p1, QPointF &p2) const;
+    void BuildPath() const;
+
+    // the path is only rebuilt once it is painted or hit-tested
+    mutable QPainterPath    m_path;
+    mutable QPainterPath    m_arrow;
+    mutable bool            m_dirty;
+    QRectF          m_bounds;
     QPointF         m_start;
     QPointF         m_end;
     Anchor          m_startAnchor;
@@ -5,6 +5,8 @@
 #include "Misc/Bubbles/cactionmodel.h"
 #include "Misc/Bubbles/cactionedit.h"
 #include "Misc/cshighlighter.h"
+#include "Misc/History/ceditbubblecommand.h"
+#include "Bubbles/cbubble.h"
 
 CActionDelegate::CActionDelegate(QObject *parent)
     : QStyledItemDelegate(parent)
@@ -43,7 +45,13 @@ void CActionDelegate::setModelData(QWidget *editor, QAbstractItemModel *model, c
         QAbstractListModel *actionModel = static_cast<QAbstractListModel *>(model);
 
         CActionEdit *actionEdit = static_cast<CActionEdit *>(editor);
-        actionModel->setData(index, actionEdit->toPlainText());
+
+        // the model belongs to its bubble, edits go through the history
+        CBubble *bubble = qobject_cast<CBubble *>(actionModel->parent());
+        if(bubble)
+            CEditBubbleCommand::Push(bubble, CSymbolTable::Action, index.row(), actionEdit->toPlainText());
+        else
+            actionModel->setData(index, actionEdit->toPlainText());
     }
 }
 
@@ -1,5 +1,7 @@
 #include "cactionedit.h"
 
+#include <QAbstractItemModel>
+
 #include "Properties/cvariablesview.h"
 #include "Misc/Variables/cvariablesmodel.h"
 #include "Misc/Variables/cvariable.h"
@@ -9,16 +11,14 @@
 #include "cgraphicsview.h"
 #include "cgraphicsscene.h"
 
-#include "Bubbles/cbubble.h"
-#include "Bubbles/cactionbubble.h"
-
 #include "Misc/cstringlistmodel.h"
 
 #include "Misc/chronicler.h"
 using Chronicler::shared;
 
+
 CActionEdit::CActionEdit(QWidget *parent)
-    : CLineEdit(parent)
+    : CLineEdit(parent), m_variablesDirty(true), m_scenesDirty(true), m_labelsDirty(true), m_revision(0), m_contextRevision(0)
 {
     setAlwaysEnabled(true);
 
@@ -27,64 +27,100 @@ CActionEdit::CActionEdit(QWidget *parent)
                       "*goto", "*goto_scene", "*hide_reuse", "*image", "*input_number", "*input_text",
                       "*label", "*line_break", "*page_break", "*rand", "*return", "*set"});
 
+    if(shared().variablesView)
+        Watch(shared().variablesView->model(), SLOT(VariablesChanged()));
+
     connect(this, SIGNAL(cursorPositionChanged()), this, SLOT(UpdateCompletionModel()));
 }
 
+void CActionEdit::Watch(QAbstractItemModel *model, const char *slot)
+{
+    connect(model, SIGNAL(rowsInserted(QModelIndex,int,int)), this, slot, Qt::UniqueConnection);
+    connect(model, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, slot, Qt::UniqueConnection);
+    connect(model, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)), this, slot, Qt::UniqueConnection);
+    connect(model, SIGNAL(modelReset()), this, slot, Qt::UniqueConnection);
+}
+
+void CActionEdit::VariablesChanged()
+{
+    m_variablesDirty = true;
+    ++m_revision;
+}
+
+void CActionEdit::ScenesChanged()
+{
+    m_scenesDirty = true;
+    ++m_revision;
+}
+
+void CActionEdit::LabelsChanged()
+{
+    m_labelsDirty = true;
+    ++m_revision;
+}
+
 void CActionEdit::UpdateVariables()
 {
-    m_variables.clear();
+    if(!m_variablesDirty)
+        return;
 
+    m_variables = shared().variablesView->model()->names().toList();
     m_variables.append({"choice_purchase_supported", "choice_purchased_adfree", "choice_is_web"});
 
-    for(const CVariable &v : shared().variablesView->model()->variables())
-        m_variables.append(v.name());
+    m_variablesDirty = false;
 }
 
 void CActionEdit::UpdateLabels(const QString &scene_name)
 {
-    m_labels.clear();
-
+    CGraphicsScene *scene = Q_NULLPTR;
     if(scene_name.isEmpty())
     {
         CGraphicsView *currentView = dynamic_cast<CGraphicsView *>(shared().sceneTabs->currentWidget());
         if(currentView)
-            AddLabelsFromScene(currentView->cScene());
+            scene = currentView->cScene();
     }
     else
     {
-        AddLabelsFromScene(shared().projectView->model()->sceneWithName(scene_name));
+        scene = shared().projectView->model()->sceneWithName(scene_name);
     }
-}
 
-void CActionEdit::AddLabelsFromScene(CGraphicsScene *scene)
-{
-    if(scene)
+    // only listen to the scene we are showing labels of
+    if(scene != m_labelScene)
     {
-        for(CBubble *b : scene->bubbles())
-        {
-            if(b->getLabel().length())
-                m_labels.append(b->getLabel());
-
-            if(b->getType() == Chronicler::ActionBubble)
-            {
-                CActionBubble *ab = static_cast<CActionBubble *>(b);
-                for(QString action : ab->actions()->stringList())
-                {
-                    QStringList words = action.split(" ", QString::SkipEmptyParts);
-                    if(words.length() > 1 && words[0] == "*label")
-                        m_labels.append(words[1]);
-                }
-            }
-        }
+        if(m_labelScene)
+            disconnect(m_labelScene, SIGNAL(labelsChanged()), this, SLOT(LabelsChanged()));
+        if(scene)
+            connect(scene, SIGNAL(labelsChanged()), this, SLOT(LabelsChanged()));
+        m_labelScene = scene;
+        m_labelsDirty = true;
     }
+
+    if(!m_labelsDirty)
+        return;
+
+    // kept up to date and in order by the scene
+    m_labels = scene ? scene->labels() : QStringList();
+    m_labelsDirty = false;
 }
 
 void CActionEdit::UpdateScenes()
 {
-    m_scenes.clear();
+    CSceneModel *model = shared().projectView->model();
+    if(model != m_sceneModel)
+    {
+        Watch(model, SLOT(ScenesChanged()));
+        m_sceneModel = model;
+        m_scenesDirty = true;
+    }
+
+    if(!m_scenesDirty)
+        return;
 
-    for(CGraphicsView *v : shared().projectView->getViews())
+    m_scenes.clear();
+    for(CGraphicsView *v : shared().projectView->model()->views())
         m_scenes.append(v->cScene()->name());
+
+    m_scenesDirty = false;
 }
 
 void CActionEdit::UpdateCompletionModel()
@@ -94,8 +130,23 @@ void CActionEdit::UpdateCompletionModel()
     QStringList words = text.split(" ");
     const int cursorIndex = text.mid(0, cursor.position()).count(" ");
 
-    m_completionModel->setStringList({});
+    // nothing to do while the cursor moves within the same word
+    QString context = QString::number(cursorIndex);
+    if(cursorIndex > 0)
+        context += " " + words[0];
+    if(cursorIndex > 1)
+        context += " " + words[1];
 
+    CGraphicsView *currentView = dynamic_cast<CGraphicsView *>(shared().sceneTabs->currentWidget());
+    CGraphicsScene *currentScene = currentView ? currentView->cScene() : Q_NULLPTR;
+
+    if(context == m_context && currentScene == m_contextScene && m_revision == m_contextRevision)
+        return;
+    m_context = context;
+    m_contextScene = currentScene;
+    m_contextRevision = m_revision;
+
+    m_completionModel->setStringList({});
     // first word
     if(cursorIndex == 0)
     {
@@ -142,12 +193,10 @@ void CActionEdit::UpdateCompletionModel()
             else if(action == "*set")
             {
                 UpdateVariables();
-                m_variables.prepend("%-");
-                m_variables.prepend("%+");
-                m_variables.prepend("-");
-                m_variables.prepend("+");
 
-                m_completionModel->setStringList(m_variables);
+                QStringList lst = {"+", "-", "%+", "%-"};
+                lst.append(m_variables);
+                m_completionModel->setStringList(lst);
             }
         }
 
@@ -1,9 +1,16 @@
 #ifndef CACTIONEDIT_H
 #define CACTIONEDIT_H
 
+#include <QPointer>
+
 #include "Misc/clineedit.h"
 
+QT_BEGIN_NAMESPACE
+class QAbstractItemModel;
+QT_END_NAMESPACE
+
 class CGraphicsScene;
+class CSceneModel;
 
 class CActionEdit : public CLineEdit
 {
@@ -15,16 +22,36 @@ public:
 private:
     void UpdateVariables();
     void UpdateLabels(const QString &scene = "");
-    void AddLabelsFromScene(CGraphicsScene *scene);
     void UpdateScenes();
 
+    void Watch(QAbstractItemModel *model, const char *slot);
+
     QStringList m_actions;
     QStringList m_variables;
     QStringList m_labels;
     QStringList m_scenes;
 
+    // the completion lists are only rebuilt after their own source changed,
+    // the completion index ranks them itself, so they are never sorted here
+    bool m_variablesDirty;
+    bool m_scenesDirty;
+    bool m_labelsDirty;
+    QPointer<CGraphicsScene> m_labelScene;
+    QPointer<CSceneModel> m_sceneModel;
+
+    // bumped whenever a source changes
+    quint64 m_revision;
+
+    // what the completion model currently holds
+    QString m_context;
+    QPointer<CGraphicsScene> m_contextScene;
+    quint64 m_contextRevision;
+
 private slots:
     void UpdateCompletionModel();
+    void VariablesChanged();
+    void ScenesChanged();
+    void LabelsChanged();
 };
 
 #endif // CACTIONEDIT_H
@@ -2,6 +2,8 @@
 
 #include <Misc/Bubbles/cchoiceedit.h>
 #include "Misc/Bubbles/cchoicemodel.h"
+#include "Misc/History/ceditbubblecommand.h"
+#include "Bubbles/cbubble.h"
 
 CChoiceDelegate::CChoiceDelegate(QObject *parent)
     : QStyledItemDelegate(parent)
@@ -41,7 +43,13 @@ void CChoiceDelegate::setModelData(QWidget *editor, QAbstractItemModel *model, c
         QAbstractListModel *choiceModel = static_cast<QAbstractListModel *>(model);
 
         CChoiceEdit *choiceEdit = static_cast<CChoiceEdit *>(editor);
-        choiceModel->setData(index, choiceEdit->toPlainText());
+
+        // the model belongs to its bubble, edits go through the history
+        CBubble *bubble = qobject_cast<CBubble *>(choiceModel->parent());
+        if(bubble)
+            CEditBubbleCommand::Push(bubble, CSymbolTable::Choice, index.row(), choiceEdit->toPlainText());
+        else
+            choiceModel->setData(index, choiceEdit->toPlainText());
     }
 }
 
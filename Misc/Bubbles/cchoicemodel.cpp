@@ -73,7 +73,11 @@ bool CChoiceModel::insertRows(int row, int count, const QModelIndex &index)
 
     CBubble *par = dynamic_cast<CBubble *>(parent());
     for(int i = row, end = row + count; i < end; ++i)
-        m_choices.insert(i, new CChoice(par->getPaletteAction(), par->getFont(), par));
+    {
+        CChoice *choice = new CChoice(par->getPaletteAction(), par->getFont(), par);
+        choice->UpdateUID();
+        m_choices.insert(i, choice);
+    }
 
     endInsertRows();
 
@@ -6,9 +6,6 @@
 #include "cgraphicsview.h"
 #include "cgraphicsscene.h"
 
-#include "Bubbles/cbubble.h"
-#include "Bubbles/cactionbubble.h"
-
 #include "Properties/cvariablesview.h"
 #include "Misc/Variables/cvariablesmodel.h"
 #include "Misc/Variables/cvariable.h"
@@ -34,9 +31,7 @@ void CCodeEdit::UpdateVariables()
     m_variables.clear();
 
     m_variables.append({"choice_purchase_supported", "choice_purchased_adfree", "choice_is_web"});
-
-    for(const CVariable &v : shared().variablesView->model()->variables())
-        m_variables.append(v.name());
+    m_variables.append(shared().variablesView->model()->names().toList());
 }
 
 void CCodeEdit::UpdateLabels(const QString &scene)
@@ -45,26 +40,10 @@ void CCodeEdit::UpdateLabels(const QString &scene)
 
     if(scene.isEmpty())
     {
+        // kept up to date by the scene
         CGraphicsView *currentView = dynamic_cast<CGraphicsView *>(shared().sceneTabs->currentWidget());
         if(currentView)
-        {
-            for(CBubble *b : currentView->cScene()->bubbles())
-            {
-                if(b->getLabel().length())
-                    m_labels.append(b->getLabel());
-
-                if(b->getType() == Chronicler::ActionBubble)
-                {
-                    CActionBubble *ab = static_cast<CActionBubble *>(b);
-                    for(QString action : ab->actions()->stringList())
-                    {
-                        QStringList words = action.split(" ", QString::SkipEmptyParts);
-                        if(words.length() > 1 && words[0] == "*label")
-                            m_labels.append(words.last());
-                    }
-                }
-            }
-        }
+            m_labels = currentView->cScene()->labels();
     }
 }
 
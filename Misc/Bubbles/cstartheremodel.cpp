@@ -40,11 +40,13 @@ bool CStartHereModel::setData(const QModelIndex &index, const QVariant &value, i
         if(index.column() == 0)
         {
             m_variables[index.row()].setName(value.toString());
+            emit dataChanged(index, index);
             return true;
         }
         else if(index.column() == 1)
         {
             m_variables[index.row()].setData(value.toString());
+            emit dataChanged(index, index);
             return true;
         }
     }
@@ -90,12 +92,12 @@ void CStartHereModel::RemoveItemAt(int row)
     endRemoveRows();
 }
 
-QList<CVariable> CStartHereModel::variables() const
+const QVector<CVariable> &CStartHereModel::variables() const
 {
     return m_variables;
 }
 
-void CStartHereModel::setVariables(const QList<CVariable> &variables)
+void CStartHereModel::setVariables(const QVector<CVariable> &variables)
 {
     beginResetModel();
     m_variables = variables;
@@ -2,6 +2,7 @@
 #define CSTARTHEREMODEL_H
 
 #include <QAbstractTableModel>
+#include <QVector>
 
 #include "Misc/Variables/cvariable.h"
 
@@ -21,11 +22,11 @@ public:
     void RemoveItem(const CVariable &item);
     void RemoveItemAt(int row);
 
-    QList<CVariable> variables() const;
-    void setVariables(const QList<CVariable> &variables);
+    const QVector<CVariable> &variables() const;
+    void setVariables(const QVector<CVariable> &variables);
 
 private:
-    QList<CVariable> m_variables;
+    QVector<CVariable> m_variables;
 };
 
 #endif // CSTARTHEREMODEL_H
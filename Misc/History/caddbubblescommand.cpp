@@ -1,42 +1,98 @@
 #include "caddbubblescommand.h"
 
+#include <QSet>
+
 #include "cgraphicsscene.h"
 #include "Bubbles/cbubble.h"
+#include "Connections/cconnection.h"
 
 #include "Misc/chronicler.h"
 
 
-CAddBubblesCommand::CAddBubblesCommand(CGraphicsScene *scene, const QList<CBubble *> &bubbles)
-    : m_scene(scene), m_bubbles(bubbles), m_undid(false)
+CAddBubblesCommand::CAddBubblesCommand(CGraphicsScene *scene, const QList<CBubble *> &bubbles, bool added)
+    : m_scene(scene), m_bubbles(bubbles), m_undid(false), m_added(added)
 {
     setText(QString("add bubble") + (bubbles.length() > 1 ? "s" : ""));
+
+    for(CBubble *bubble : m_bubbles)
+        m_uids.append(bubble->getUID());
 }
 
 CAddBubblesCommand::~CAddBubblesCommand()
 {
     if(m_undid)
+    {
+        // connections first, they unlink themselves from both ends
+        for(CConnection *c : m_connections)
+            c->deleteLater();
+
         for(CBubble *bubble : m_bubbles)
             bubble->deleteLater();
+    }
 }
 
 
 void CAddBubblesCommand::undo()
 {
+    // a connection between two of the bubbles is found from both ends
+    QSet<CConnection *> found;
+    m_connections.clear();
+    for(CBubble *bubble : m_bubbles)
+    {
+        for(CConnection *c : bubble->connections() + bubble->links())
+        {
+            if(c && !found.contains(c))
+            {
+                found.insert(c);
+                m_connections.append(c);
+            }
+        }
+    }
+
+    CGraphicsScene::Batch batch(m_scene);
+
+    for(CConnection *c : m_connections)
+        m_scene->RemoveConnection(c);
+
     for(CBubble *bubble : m_bubbles)
         m_scene->RemoveBubble(bubble);
 
     m_undid = true;
+    CostChanged();
 }
 
 void CAddBubblesCommand::redo()
 {
-    for(CBubble *bubble : m_bubbles)
-        m_scene->AddBubble(bubble);
+    if(m_added)
+        m_added = false;
+    else
+    {
+        CGraphicsScene::Batch batch(m_scene);
+
+        for(CBubble *bubble : m_bubbles)
+            m_scene->AddBubble(bubble);
+
+        for(CConnection *c : m_connections)
+            m_scene->AddConnection(c);
+    }
 
     m_undid = false;
+    CostChanged();
 }
 
 int CAddBubblesCommand::id() const
 {
     return Chronicler::AddBubblesCommand;
 }
+
+qint64 CAddBubblesCommand::cost() const
+{
+    // once undone, the bubbles are only kept alive by this command
+    return sizeof(*this) + (m_undid ? m_bubbles.length() * BubbleCost + m_connections.length() * ConnectionCost : 0);
+}
+
+void CAddBubblesCommand::RemapBubbles(const QHash<t_uid, CBubble *> &bubbles)
+{
+    for(int i = 0; i < m_bubbles.length(); ++i)
+        m_bubbles[i] = bubbles.value(m_uids[i], m_bubbles[i]);
+}
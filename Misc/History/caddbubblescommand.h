@@ -1,31 +1,42 @@
 #ifndef CADDBUBBLECOMMAND_H
 #define CADDBUBBLECOMMAND_H
 
-#include <QUndoCommand>
+#include "chistorycommand.h"
 
 #include "Misc/chronicler.h"
 using Chronicler::BubbleType;
 
 class CGraphicsScene;
 class CBubble;
+class CConnection;
 
-class CAddBubblesCommand : public QUndoCommand
+class CAddBubblesCommand : public CHistoryCommand
 {
 public:
-    CAddBubblesCommand(CGraphicsScene *scene, const QList<CBubble *> &bubbles);
+    CAddBubblesCommand(CGraphicsScene *scene, const QList<CBubble *> &bubbles, bool added = false);
     ~CAddBubblesCommand();
 
     virtual void undo() Q_DECL_OVERRIDE;
     virtual void redo() Q_DECL_OVERRIDE;
     virtual int id() const Q_DECL_OVERRIDE;
 
+    virtual qint64 cost() const Q_DECL_OVERRIDE;
+    virtual void RemapBubbles(const QHash<t_uid, CBubble *> &bubbles) Q_DECL_OVERRIDE;
+
 private:
     CGraphicsScene *m_scene;
     QList<CBubble *> m_bubbles;
+    QList<t_uid> m_uids;
     BubbleType m_type;
 
+    // connections of the bubbles when they were taken out of the scene
+    QList<CConnection *> m_connections;
+
     bool m_undid;
 
+    // the bubbles were already in the scene when the command was pushed
+    bool m_added;
+
 };
 
 #endif // CADDBUBBLECOMMAND_H
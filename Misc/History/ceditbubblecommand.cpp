@@ -0,0 +1,194 @@
+#include "ceditbubblecommand.h"
+
+#include <QUndoStack>
+#include <QTimer>
+#include <QStatusBar>
+
+#include "Bubbles/cbubble.h"
+#include "Bubbles/cactionbubble.h"
+#include "Bubbles/cchoicebubble.h"
+#include "Bubbles/cchoice.h"
+#include "Misc/cstringlistmodel.h"
+
+#include "Misc/chronicler.h"
+using Chronicler::shared;
+
+
+bool CEditBubbleCommand::m_applying = false;
+
+CEditBubbleCommand::CEditBubbleCommand(CBubble *bubble, CSymbolTable::Field field, int index, const QString &oldText, const QString &newText)
+    : m_bubble(bubble), m_uid(bubble->getUID()), m_field(field), m_rowId(RowId(bubble, field, index)),
+      m_oldHash(qHash(oldText)), m_newHash(qHash(newText))
+{
+    setText("edit bubble");
+
+    // only keep the part between the common prefix and suffix
+    const int len = qMin(oldText.length(), newText.length());
+
+    int prefix = 0;
+    while(prefix < len && oldText.at(prefix) == newText.at(prefix))
+        ++prefix;
+
+    int suffix = 0;
+    while(suffix < len - prefix && oldText.at(oldText.length() - suffix - 1) == newText.at(newText.length() - suffix - 1))
+        ++suffix;
+
+    m_position = prefix;
+    m_removed = oldText.mid(prefix, oldText.length() - prefix - suffix);
+    m_inserted = newText.mid(prefix, newText.length() - prefix - suffix);
+}
+
+void CEditBubbleCommand::undo()
+{
+    Apply(m_inserted, m_removed, m_newHash);
+}
+
+void CEditBubbleCommand::redo()
+{
+    Apply(m_removed, m_inserted, m_oldHash);
+}
+
+int CEditBubbleCommand::id() const
+{
+    return Chronicler::EditBubbleCommand;
+}
+
+/**
+ * @brief Typing or deleting right next to the previous edit of the same field extends it.
+ */
+bool CEditBubbleCommand::mergeWith(const QUndoCommand *other)
+{
+    const CEditBubbleCommand *edit = dynamic_cast<const CEditBubbleCommand *>(other);
+
+    if(!edit || edit->m_bubble != m_bubble || edit->m_field != m_field || edit->m_rowId != m_rowId)
+        return false;
+
+    // a new line starts a new burst
+    if(edit->m_inserted.contains('\n'))
+        return false;
+
+    // typing
+    if(m_removed.isEmpty() && edit->m_removed.isEmpty() && edit->m_position == m_position + m_inserted.length())
+    {
+        m_inserted += edit->m_inserted;
+        m_newHash = edit->m_newHash;
+        CostChanged();
+        return true;
+    }
+
+    if(m_inserted.isEmpty() && edit->m_inserted.isEmpty())
+    {
+        // backspace
+        if(edit->m_position + edit->m_removed.length() == m_position)
+        {
+            m_position = edit->m_position;
+            m_removed.prepend(edit->m_removed);
+            m_newHash = edit->m_newHash;
+            CostChanged();
+            return true;
+        }
+
+        // delete
+        if(edit->m_position == m_position)
+        {
+            m_removed += edit->m_removed;
+            m_newHash = edit->m_newHash;
+            CostChanged();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+qint64 CEditBubbleCommand::cost() const
+{
+    return sizeof(*this) + (m_removed.length() + m_inserted.length()) * sizeof(QChar);
+}
+
+void CEditBubbleCommand::RemapBubbles(const QHash<t_uid, CBubble *> &bubbles)
+{
+    m_bubble = bubbles.value(m_uid, m_bubble);
+}
+
+void CEditBubbleCommand::Push(CBubble *bubble, CSymbolTable::Field field, int index, const QString &newText)
+{
+    if(!bubble || m_applying)
+        return;
+
+    const QString oldText = CSymbolTable::Text(bubble, field, index);
+    if(oldText != newText)
+        shared().history->push(new CEditBubbleCommand(bubble, field, index, oldText, newText));
+}
+
+bool CEditBubbleCommand::isApplying()
+{
+    return m_applying;
+}
+
+/**
+ * @brief Writes the edit to its field if the field still holds the text it expects.
+ *        Otherwise the field was changed outside of the history, e.g. by renaming a variable
+ *        or removing the row, and the history can no longer be trusted.
+ */
+void CEditBubbleCommand::Apply(const QString &remove, const QString &insert, uint expected)
+{
+    const int index = row();
+    QString text = (index < 0) ? QString() : CSymbolTable::Text(m_bubble, m_field, index);
+
+    if(index < 0 || qHash(text) != expected ||
+       m_position > text.length() || text.midRef(m_position, remove.length()) != remove)
+    {
+        // the stack is still executing this command, clear it once it is done
+        QTimer::singleShot(0, shared().history, []() {
+            shared().history->clear();
+            shared().statusBar->showMessage("The history no longer matches the project and was cleared", 10000);
+        });
+        return;
+    }
+
+    text.replace(m_position, remove.length(), insert);
+
+    m_applying = true;
+    CSymbolTable::setText(m_bubble, m_field, index, text);
+    m_applying = false;
+}
+
+/**
+ * @brief Current row of the edited action or choice, -1 if it is gone.
+ */
+int CEditBubbleCommand::row() const
+{
+    if(m_field == CSymbolTable::Action)
+        return static_cast<CActionBubble *>(m_bubble)->actions()->rowWithId(m_rowId);
+
+    if(m_field == CSymbolTable::Choice)
+    {
+        const CChoiceBubble::choiceList choices = static_cast<CChoiceBubble *>(m_bubble)->choiceBubbles();
+        for(int i = 0; i < choices.length(); ++i)
+            if(choices.at(i)->getUID() == m_rowId)
+                return i;
+
+        return -1;
+    }
+
+    return static_cast<int>(m_rowId);
+}
+
+/**
+ * @brief Identity of the row at index that moves along with it, the choice UID or
+ *        the row id of the action, the index itself for every other field.
+ */
+quint64 CEditBubbleCommand::RowId(CBubble *bubble, CSymbolTable::Field field, int index)
+{
+    if(field == CSymbolTable::Action)
+        return static_cast<CActionBubble *>(bubble)->actions()->rowId(index);
+
+    if(field == CSymbolTable::Choice)
+    {
+        CChoice *choice = static_cast<CChoiceBubble *>(bubble)->choiceBubbles().value(index);
+        return choice ? choice->getUID() : 0;
+    }
+
+    return index;
+}
@@ -0,0 +1,56 @@
+#ifndef CEDITBUBBLECOMMAND_H
+#define CEDITBUBBLECOMMAND_H
+
+#include "chistorycommand.h"
+
+#include "Misc/Variables/csymboltable.h"
+
+/**
+ * @brief Edit of a text field of a bubble.
+ * Only the changed part of the text is stored, consecutive typing and
+ * deleting in the same field merge into a single command.
+ * Actions and choices are found by the id of their row, not its position,
+ * and the history is cleared if the field no longer holds the expected text.
+ */
+class CEditBubbleCommand : public CHistoryCommand
+{
+public:
+    CEditBubbleCommand(CBubble *bubble, CSymbolTable::Field field, int index, const QString &oldText, const QString &newText);
+
+    virtual void undo() Q_DECL_OVERRIDE;
+    virtual void redo() Q_DECL_OVERRIDE;
+    virtual int id() const Q_DECL_OVERRIDE;
+    virtual bool mergeWith(const QUndoCommand *other) Q_DECL_OVERRIDE;
+
+    virtual qint64 cost() const Q_DECL_OVERRIDE;
+    virtual void RemapBubbles(const QHash<t_uid, CBubble *> &bubbles) Q_DECL_OVERRIDE;
+
+    /// @brief pushes an edit of the field to the history, unless nothing changed or an edit is being applied
+    static void Push(CBubble *bubble, CSymbolTable::Field field, int index, const QString &newText);
+
+    /// @brief true while an edit is written to a bubble
+    static bool isApplying();
+
+private:
+    void Apply(const QString &remove, const QString &insert, uint expected);
+    int row() const;
+
+    static quint64 RowId(CBubble *bubble, CSymbolTable::Field field, int index);
+
+    CBubble *m_bubble;
+    t_uid m_uid;
+    CSymbolTable::Field m_field;
+    quint64 m_rowId;
+
+    // hashes of the whole field before and after this edit
+    uint m_oldHash;
+    uint m_newHash;
+
+    int m_position;
+    QString m_removed;
+    QString m_inserted;
+
+    static bool m_applying;
+};
+
+#endif // CEDITBUBBLECOMMAND_H
@@ -0,0 +1,85 @@
+#include "chistorycommand.h"
+
+
+quint64 CHistoryCommand::m_nextSequence = 0;
+qint64 CHistoryCommand::m_totalCost = 0;
+QMap<quint64, CHistoryCommand *> CHistoryCommand::m_commands = QMap<quint64, CHistoryCommand *>();
+QMap<quint64, CHistoryCommand *> CHistoryCommand::m_freezable = QMap<quint64, CHistoryCommand *>();
+QSet<CHistoryCommand *> CHistoryCommand::m_changed = QSet<CHistoryCommand *>();
+
+CHistoryCommand::CHistoryCommand(QUndoCommand *parent)
+    : QUndoCommand(parent), m_sequence(m_nextSequence++), m_cost(0)
+{
+    m_commands.insert(m_sequence, this);
+    m_changed.insert(this);
+}
+
+CHistoryCommand::~CHistoryCommand()
+{
+    m_commands.remove(m_sequence);
+    m_freezable.remove(m_sequence);
+    m_changed.remove(this);
+    m_totalCost -= m_cost;
+}
+
+qint64 CHistoryCommand::cost() const
+{
+    return sizeof(CHistoryCommand);
+}
+
+bool CHistoryCommand::Freeze()
+{
+    return false;
+}
+
+void CHistoryCommand::RemapBubbles(const QHash<t_uid, CBubble *> &)
+{}
+
+void CHistoryCommand::Compact(qint64 budget)
+{
+    for(CHistoryCommand *command : m_changed)
+        command->UpdateCost();
+    m_changed.clear();
+
+    for(QMap<quint64, CHistoryCommand *>::iterator it = m_freezable.begin(); it != m_freezable.end() && m_totalCost > budget;)
+    {
+        CHistoryCommand *command = it.value();
+        it = m_freezable.erase(it);
+
+        if(command->Freeze())
+            command->UpdateCost();
+    }
+}
+
+void CHistoryCommand::RemapOlderCommands(const QHash<t_uid, CBubble *> &bubbles)
+{
+    if(bubbles.isEmpty())
+        return;
+
+    QMap<quint64, CHistoryCommand *>::iterator it = m_commands.find(m_sequence);
+    while(it != m_commands.begin())
+    {
+        --it;
+        it.value()->RemapBubbles(bubbles);
+    }
+}
+
+void CHistoryCommand::CostChanged()
+{
+    m_changed.insert(this);
+}
+
+void CHistoryCommand::setFreezable(bool freezable)
+{
+    if(freezable)
+        m_freezable.insert(m_sequence, this);
+    else
+        m_freezable.remove(m_sequence);
+}
+
+void CHistoryCommand::UpdateCost()
+{
+    const qint64 current = cost();
+    m_totalCost += current - m_cost;
+    m_cost = current;
+}
@@ -0,0 +1,72 @@
+#ifndef CHISTORYCOMMAND_H
+#define CHISTORYCOMMAND_H
+
+#include <QUndoCommand>
+#include <QHash>
+#include <QMap>
+#include <QSet>
+
+#include "Misc/chronicler.h"
+using Chronicler::t_uid;
+
+class CBubble;
+
+/**
+ * @brief Base of every command pushed on the history.
+ * Keeps track of the commands in the order they were pushed, so that the
+ * history can be compacted and bubbles recreated by an undo can be handed
+ * to the older commands that still refer to them.
+ */
+class CHistoryCommand : public QUndoCommand
+{
+public:
+    explicit CHistoryCommand(QUndoCommand *parent = Q_NULLPTR);
+    virtual ~CHistoryCommand();
+
+    /// @brief rough number of bytes kept alive by this command
+    virtual qint64 cost() const;
+
+    /// @brief stores what this command keeps alive in a compact form, returns false if there is nothing to store
+    virtual bool Freeze();
+
+    /// @brief points this command at bubbles that were recreated in place of deleted ones, by UID
+    virtual void RemapBubbles(const QHash<t_uid, CBubble *> &bubbles);
+
+    /// @brief freezes the oldest commands until the history fits in budget bytes
+    static void Compact(qint64 budget);
+
+protected:
+    /// @brief hands recreated bubbles to the commands pushed before this one
+    void RemapOlderCommands(const QHash<t_uid, CBubble *> &bubbles);
+
+    /// @brief to be called whenever cost() changes, the total is updated on the next Compact()
+    void CostChanged();
+
+    /// @brief whether Compact() may try to freeze this command
+    void setFreezable(bool freezable);
+
+    // rough size of a live bubble and connection, with their graphics and text items
+    static const qint64 BubbleCost = 4096;
+    static const qint64 ConnectionCost = 512;
+
+private:
+    void UpdateCost();
+
+    // position of this command in the history
+    quint64 m_sequence;
+
+    // cost() as last counted in m_totalCost
+    qint64 m_cost;
+
+    static quint64 m_nextSequence;
+    static qint64 m_totalCost;
+
+    // every command on the history and the ones that may be frozen, by position
+    static QMap<quint64, CHistoryCommand *> m_commands;
+    static QMap<quint64, CHistoryCommand *> m_freezable;
+
+    // commands whose cost changed since the last Compact()
+    static QSet<CHistoryCommand *> m_changed;
+};
+
+#endif // CHISTORYCOMMAND_H
@@ -7,6 +7,9 @@ CMoveBubbleCommand::CMoveBubbleCommand(const QList<MoveData> &data)
     : m_moveData(data)
 {
         setText(QString("move bubble") + (data.length() > 1 ? "s" : ""));
+
+    for(int i = 0; i < m_moveData.length(); ++i)
+        m_moveData[i].uid = m_moveData[i].bubble->getUID();
 }
 
 void CMoveBubbleCommand::undo()
@@ -27,3 +30,34 @@ int CMoveBubbleCommand::id() const
 {
     return Chronicler::MoveBubblesCommand;
 }
+
+/**
+ * @brief Consecutive moves of the same selection become a single move.
+ */
+bool CMoveBubbleCommand::mergeWith(const QUndoCommand *other)
+{
+    const CMoveBubbleCommand *moveCommand = dynamic_cast<const CMoveBubbleCommand *>(other);
+
+    if(!moveCommand || moveCommand->m_moveData.length() != m_moveData.length())
+        return false;
+
+    for(int i = 0; i < m_moveData.length(); ++i)
+        if(moveCommand->m_moveData[i].bubble != m_moveData[i].bubble)
+            return false;
+
+    for(int i = 0; i < m_moveData.length(); ++i)
+        m_moveData[i].newPos = moveCommand->m_moveData[i].newPos;
+
+    return true;
+}
+
+qint64 CMoveBubbleCommand::cost() const
+{
+    return sizeof(*this) + m_moveData.length() * sizeof(MoveData);
+}
+
+void CMoveBubbleCommand::RemapBubbles(const QHash<t_uid, CBubble *> &bubbles)
+{
+    for(int i = 0; i < m_moveData.length(); ++i)
+        m_moveData[i].bubble = bubbles.value(m_moveData[i].uid, m_moveData[i].bubble);
+}
@@ -1,20 +1,21 @@
 #ifndef CMOVEBUBBLECOMMAND_H
 #define CMOVEBUBBLECOMMAND_H
 
-#include <QUndoCommand>
+#include "chistorycommand.h"
 #include <QPointF>
 
 class CBubble;
 
-class CMoveBubbleCommand : public QUndoCommand
+class CMoveBubbleCommand : public CHistoryCommand
 {
 public:
     struct MoveData {
         CBubble *bubble;
+        t_uid uid;
         QPointF oldPos;
         QPointF newPos;
 
-        MoveData(CBubble *b, const QPointF &o, const QPointF &n) : bubble(b), oldPos(o), newPos(n) {}
+        MoveData(CBubble *b, const QPointF &o, const QPointF &n) : bubble(b), uid(0), oldPos(o), newPos(n) {}
         bool operator ==(const MoveData &rhs) { return bubble == rhs.bubble; }
     };
 
@@ -23,6 +24,10 @@ public:
     virtual void undo() Q_DECL_OVERRIDE;
     virtual void redo() Q_DECL_OVERRIDE;
     virtual int id() const Q_DECL_OVERRIDE;
+    virtual bool mergeWith(const QUndoCommand *other) Q_DECL_OVERRIDE;
+
+    virtual qint64 cost() const Q_DECL_OVERRIDE;
+    virtual void RemapBubbles(const QHash<t_uid, CBubble *> &bubbles) Q_DECL_OVERRIDE;
 
 private:
     QList<MoveData> m_moveData;
@@ -1,28 +1,39 @@
 #include "cremovebubblescommand.h"
 
+#include <QDataStream>
+#include <QSet>
+
 #include "cgraphicsscene.h"
 #include "Bubbles/cbubble.h"
 #include "Connections/cconnection.h"
+#include "Misc/cserializable.h"
 
 #include "Misc/chronicler.h"
+using Chronicler::shared;
 
 CRemoveBubblesCommand::CRemoveBubblesCommand(CGraphicsScene *scene, const QList<CBubble *> &bubbles)
-    : m_scene(scene), m_bubbles(bubbles), m_did(true)
+    : m_scene(scene), m_bubbles(bubbles), m_did(true), m_frozen(false)
 {
     setText(QString("remove bubble") + (m_bubbles.length() > 1 ? "s" : ""));
 
+    // a connection between two of the bubbles is found from both ends
+    QSet<CConnection *> found;
     for(CBubble *bbl : m_bubbles)
     {
-        m_connections.append(bbl->connections());
-        m_connections.append(bbl->links());
+        for(CConnection *c : bbl->connections() + bbl->links())
+        {
+            if(c && !found.contains(c))
+            {
+                found.insert(c);
+                m_connections.append(c);
+            }
+        }
     }
-
-    m_connections.removeAll(Q_NULLPTR);
 }
 
 CRemoveBubblesCommand::~CRemoveBubblesCommand()
 {
-    if(m_did)
+    if(m_did && !m_frozen)
     {
         for(CBubble *bubble : m_bubbles)
             bubble->deleteLater();
@@ -34,17 +45,27 @@ CRemoveBubblesCommand::~CRemoveBubblesCommand()
 
 void CRemoveBubblesCommand::undo()
 {
-    for(CBubble *bubble : m_bubbles)
-        m_scene->AddBubble(bubble);
+    if(m_frozen)
+        Thaw();
+    else
+    {
+        CGraphicsScene::Batch batch(m_scene);
 
-    for(CConnection *c : m_connections)
-        m_scene->AddConnection(c);
+        for(CBubble *bubble : m_bubbles)
+            m_scene->AddBubble(bubble);
+
+        for(CConnection *c : m_connections)
+            m_scene->AddConnection(c);
+    }
 
     m_did = false;
+    setFreezable(false);
 }
 
 void CRemoveBubblesCommand::redo()
 {
+    CGraphicsScene::Batch batch(m_scene);
+
     for(CBubble *bubble : m_bubbles)
         m_scene->RemoveBubble(bubble);
 
@@ -52,9 +73,130 @@ void CRemoveBubblesCommand::redo()
         m_scene->RemoveConnection(c);
 
     m_did = true;
+    setFreezable(true);
 }
 
 int CRemoveBubblesCommand::id() const
 {
     return Chronicler::RemoveBubblesCommand;
 }
+
+qint64 CRemoveBubblesCommand::cost() const
+{
+    if(m_frozen)
+        return sizeof(*this) + m_data.size() + m_frozenConnections.length() * sizeof(FrozenConnection);
+
+    return sizeof(*this) + m_bubbles.length() * BubbleCost + m_connections.length() * ConnectionCost;
+}
+
+/**
+ * @brief Serializes the removed bubbles and their connections, then deletes them.
+ */
+bool CRemoveBubblesCommand::Freeze()
+{
+    if(!m_did || m_frozen)
+        return false;
+
+    // links of the removed bubbles are serialized with them,
+    // only the connections coming in from outside are stored separately
+    const QHash<t_uid, CBubble *> removed = CGraphicsScene::BubblesByUID(m_bubbles);
+    for(CConnection *c : m_connections)
+    {
+        FrozenConnection fc = { c->from()->getUID(), c->to()->getUID(), c->startAnchor(), c->endAnchor() };
+        if(!removed.contains(fc.from))
+            m_frozenConnections.append(fc);
+
+        if(!removed.contains(fc.from))
+            m_outside.insert(fc.from, c->from());
+        if(!removed.contains(fc.to))
+            m_outside.insert(fc.to, c->to());
+    }
+
+    QDataStream ds(&m_data, QIODevice::WriteOnly);
+    ds << static_cast<qint32>(m_bubbles.length());
+    for(CBubble *bubble : m_bubbles)
+        ds << *bubble;
+
+    // connections first, they unlink themselves from both ends
+    qDeleteAll(m_connections);
+    m_connections.clear();
+
+    qDeleteAll(m_bubbles);
+    m_bubbles.clear();
+
+    m_frozen = true;
+    return true;
+}
+
+/**
+ * @brief Recreates the removed bubbles and their connections in the scene.
+ */
+void CRemoveBubblesCommand::Thaw()
+{
+    CSerializable::VersionOverride version(shared().ProgramVersion);
+    CGraphicsScene::Batch batch(m_scene);
+    QDataStream ds(m_data);
+
+    // the links read with the bubbles are appended to the scene
+    const int firstConnection = m_scene->connections().length();
+
+    qint32 len, type;
+    ds >> len;
+    for(int i = 0; i < len; ++i)
+    {
+        ds >> type;
+        CBubble *bubble = m_scene->CreateBubble(BubbleType(type), QPointF());
+        m_scene->AddBubble(bubble);
+        ds >> *bubble;
+        m_bubbles.append(bubble);
+    }
+
+    // a recreated bubble reads the UID of the bubble it replaces
+    const QHash<t_uid, CBubble *> recreated = CGraphicsScene::BubblesByUID(m_bubbles);
+    QHash<t_uid, CBubble *> bubbles = recreated;
+    bubbles.unite(m_outside);
+
+    // hook up the links through the UIDs they were read with, like a loaded scene
+    const QList<CConnection *> links = m_scene->connections().mid(firstConnection);
+    for(CConnection *link : links)
+    {
+        if(!link->isConnected())
+            link->ConnectToUIDs(bubbles);
+        if(link->isConnected())
+            m_connections.append(link);
+    }
+
+    for(const FrozenConnection &fc : m_frozenConnections)
+    {
+        CBubble *from = bubbles.value(fc.from);
+        CBubble *to = bubbles.value(fc.to);
+        if(from && to)
+            m_connections.append(m_scene->AddConnection(from, to, fc.startAnchor, fc.endAnchor));
+    }
+
+    m_data.clear();
+    m_frozenConnections.clear();
+    m_outside.clear();
+    m_frozen = false;
+    CostChanged();
+
+    RemapOlderCommands(recreated);
+}
+
+/**
+ * @brief The removed bubbles are owned by this command and never deleted while it is
+ *        done, only the bubbles outside of them can have been recreated.
+ */
+void CRemoveBubblesCommand::RemapBubbles(const QHash<t_uid, CBubble *> &bubbles)
+{
+    if(m_frozen)
+    {
+        for(QHash<t_uid, CBubble *>::iterator it = m_outside.begin(); it != m_outside.end(); ++it)
+            it.value() = bubbles.value(it.key(), it.value());
+    }
+    else
+    {
+        for(CConnection *c : m_connections)
+            c->ReplaceBubbles(bubbles);
+    }
+}
@@ -1,16 +1,26 @@
 #ifndef CREMOVEBUBBLESCOMMAND_H
 #define CREMOVEBUBBLESCOMMAND_H
 
-#include <QUndoCommand>
+#include "chistorycommand.h"
+
+#include <QByteArray>
+#include <QHash>
 
 #include "Misc/chronicler.h"
 using Chronicler::BubbleType;
+using Chronicler::Anchor;
+using Chronicler::t_uid;
 
 class CGraphicsScene;
 class CBubble;
 class CConnection;
 
-class CRemoveBubblesCommand : public QUndoCommand
+/**
+ * @brief Removes bubbles along with their connections.
+ * Once frozen, the removed bubbles are kept as serialized bytes instead of
+ * live items and are only recreated when the command is undone.
+ */
+class CRemoveBubblesCommand : public CHistoryCommand
 {
 public:
     CRemoveBubblesCommand(CGraphicsScene *scene, const QList<CBubble *> &bubbles);
@@ -20,13 +30,32 @@ public:
     virtual void redo() Q_DECL_OVERRIDE;
     virtual int id() const Q_DECL_OVERRIDE;
 
+    virtual qint64 cost() const Q_DECL_OVERRIDE;
+    virtual bool Freeze() Q_DECL_OVERRIDE;
+    virtual void RemapBubbles(const QHash<t_uid, CBubble *> &bubbles) Q_DECL_OVERRIDE;
+
 private:
+    struct FrozenConnection
+    {
+        t_uid from;
+        t_uid to;
+        Anchor startAnchor;
+        Anchor endAnchor;
+    };
+
+    void Thaw();
+
     CGraphicsScene *m_scene;
     QList<CBubble *> m_bubbles;
     QList<CConnection *> m_connections;
 
     bool m_did;
 
+    // frozen state
+    bool m_frozen;
+    QByteArray m_data;
+    QList<FrozenConnection> m_frozenConnections;
+    QHash<t_uid, CBubble *> m_outside;   // bubbles outside the removed ones, by UID
 };
 
 #endif // CREMOVEBUBBLESCOMMAND_H
@@ -6,6 +6,7 @@
 #include "Misc/cscenemodel.h"
 
 #include "cgraphicsview.h"
+#include "cgraphicsscene.h"
 
 #include "Misc/chronicler.h"
 using Chronicler::shared;
@@ -36,3 +37,9 @@ int CRemoveSceneCommand::id() const
 {
     return Chronicler::RemoveSceneCommand;
 }
+
+qint64 CRemoveSceneCommand::cost() const
+{
+    return sizeof(*this) + m_view->cScene()->bubbles().length() * BubbleCost
+                         + m_view->cScene()->connections().length() * ConnectionCost;
+}
@@ -1,11 +1,11 @@
 #ifndef CREMOVESCENECOMMAND_H
 #define CREMOVESCENECOMMAND_H
 
-#include <QUndoCommand>
+#include "chistorycommand.h"
 
 class CGraphicsView;
 
-class CRemoveSceneCommand : public QUndoCommand
+class CRemoveSceneCommand : public CHistoryCommand
 {
 public:
     CRemoveSceneCommand(CGraphicsView *view, int index);
@@ -15,6 +15,8 @@ public:
     virtual void redo() Q_DECL_OVERRIDE;
     virtual int id() const Q_DECL_OVERRIDE;
 
+    virtual qint64 cost() const Q_DECL_OVERRIDE;
+
 private:
     CGraphicsView *m_view;
     int m_index;
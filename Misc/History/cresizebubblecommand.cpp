@@ -5,7 +5,7 @@
 #include "Misc/chronicler.h"
 
 CResizeBubbleCommand::CResizeBubbleCommand(CBubble *bubble, const QRectF &oldSize, const QRectF &newSize)
-    : m_bubble(bubble), m_oldSize(oldSize), m_newSize(newSize)
+    : m_bubble(bubble), m_uid(bubble->getUID()), m_oldSize(oldSize), m_newSize(newSize)
 {
     setText("resize bubble");
 }
@@ -39,3 +39,8 @@ bool CResizeBubbleCommand::mergeWith(const QUndoCommand *other)
 
     return false;
 }
+
+void CResizeBubbleCommand::RemapBubbles(const QHash<t_uid, CBubble *> &bubbles)
+{
+    m_bubble = bubbles.value(m_uid, m_bubble);
+}
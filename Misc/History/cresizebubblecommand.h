@@ -1,12 +1,12 @@
 #ifndef CRESIZEBUBBLECOMMAND_H
 #define CRESIZEBUBBLECOMMAND_H
 
-#include <QUndoCommand>
+#include "chistorycommand.h"
 #include <QRectF>
 
 class CBubble;
 
-class CResizeBubbleCommand : public QUndoCommand
+class CResizeBubbleCommand : public CHistoryCommand
 {
 public:
     CResizeBubbleCommand(CBubble *bubble, const QRectF &oldSize, const QRectF &newSize);
@@ -16,8 +16,11 @@ public:
     virtual int id() const Q_DECL_OVERRIDE;
     virtual bool mergeWith(const QUndoCommand *other) Q_DECL_OVERRIDE;
 
+    virtual void RemapBubbles(const QHash<t_uid, CBubble *> &bubbles) Q_DECL_OVERRIDE;
+
 private:
     CBubble *m_bubble;
+    t_uid m_uid;
     QRectF m_oldSize;
     QRectF m_newSize;
 };
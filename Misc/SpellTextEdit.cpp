@@ -3,111 +3,46 @@
 #include <QTextBlock>
 #include <QMenu>
 #include <QContextMenuEvent>
-#include <QFileInfo>
-#include <QTextCodec>
-#include <QSettings>
-#include <QTextStream>
 #include <QCoreApplication>
 
 #include "Misc/highlighter.h"
+#include "Misc/cdictionary.h"
+#include "Misc/cspellchecker.h"
 
 
 SpellTextEdit::SpellTextEdit(QWidget *parent, QString SpellDic)
-    : QTextEdit(parent)
+    : QTextEdit(parent), checker(0)
 {
     //    SpellDic = QCoreApplication::applicationDirPath() + "/en_GB.dic";
 
     createActions();
     // create misspell actions in context menu
-    spell_dic=SpellDic.left(SpellDic.length()-4);
-    pChecker = new Hunspell(spell_dic.toLatin1()+".aff",spell_dic.toLatin1()+".dic");
-
-    QFileInfo fi(SpellDic);
-    if (!(fi.exists() && fi.isReadable())){
-        delete pChecker;
-        pChecker=0;
-    }
-    // get user config dictionary
-    QSettings setting;
-    QString filePath=QFileInfo(setting.fileName()).absoluteFilePath();
-    filePath=filePath+"/User_"+QFileInfo(spell_dic.toLatin1()+".dic").fileName();
-    //	std::cout << qPrintable(filePath) << std::endl;
-    fi=QFileInfo(filePath);
-    if (fi.exists() && fi.isReadable()){
-        pChecker->add_dic(filePath.toLatin1());
-    }
-    else filePath="";
-
-    addedWords.clear();
+    if(SpellDic!="")
+        setDict(SpellDic);
 }
 
 
 SpellTextEdit::~SpellTextEdit()
 {
-    // write user dictionary
-    QSettings setting;
-    QString fileName=QFileInfo(setting.fileName()).absoluteFilePath();
-    fileName=fileName+"/User_"+QFileInfo(spell_dic.toLatin1()+".dic").fileName();
-    //	std::cout << qPrintable(fileName) << std::endl;
-    QFile file(fileName);
-    if (file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        QTextStream in(&file);
-        in.readLine();
-        while (!in.atEnd()) {
-            QString line = in.readLine();
-            if(!addedWords.contains(line)) addedWords << line;
-        }
-        file.close();
-    }
-    if (pChecker && file.open(QIODevice::WriteOnly | QIODevice::Text))
-    {
-        //		std::cout << "write" << std::endl;
-
-        QTextStream out(&file);
-        QByteArray encodedString;
-        QString spell_encoding=QString(pChecker->get_dic_encoding());
-        QTextCodec *codec = QTextCodec::codecForName(spell_encoding.toLatin1());
-        out << addedWords.count() << "\n";
-        foreach(QString elem, addedWords){
-            encodedString = codec->fromUnicode(elem);
-            out << encodedString.data() << "\n";
-            //			std::cout << encodedString.data() << std::endl;
-        }
-    }
+    // the user dictionary is written by the shared dictionary itself
+    if(checker)
+        checker->deleteLater();
 }
 
 bool SpellTextEdit::setDict(const QString SpellDic)
 {
-    if(SpellDic!=""){
-        //mWords.clear();
-        spell_dic=SpellDic.left(SpellDic.length()-4);
-        delete pChecker;
-        pChecker = new Hunspell(spell_dic.toLatin1()+".aff",spell_dic.toLatin1()+".dic");
-    }
-    else spell_dic="";
-
-    QFileInfo fi(SpellDic);
-    if (!(fi.exists() && fi.isReadable()))
-    {
-        delete pChecker;
-        pChecker=0;
-    }
+    if(SpellDic!="")
+        dictionary = CDictionary::Acquire(SpellDic);
     else
-    {
-        // get user config dictionary
-        QSettings setting;
-        QString filePath=QFileInfo(setting.fileName()).absoluteFilePath();
-        filePath=filePath+"/User_"+QFileInfo(spell_dic.toLatin1()+".dic").fileName();
-        //		std::cout << qPrintable(filePath) << std::endl;
-        fi=QFileInfo(filePath);
-        if (fi.exists() && fi.isReadable()){
-            pChecker->add_dic(filePath.toLatin1());
-        }
-        else filePath="";
-    }
+        dictionary.clear();
+
+    if(checker)
+        checker->deleteLater();
+    checker = new CSpellChecker(dictionary);
+    connect(this, SIGNAL(suggest(QString)), checker, SLOT(Suggest(QString)));
+    connect(checker, SIGNAL(Suggested(QString,bool,QStringList)), this, SLOT(slot_suggested(QString,bool,QStringList)));
 
-    return (spell_dic!="");
+    return (dictionary && dictionary->isValid());
 }
 
 
@@ -143,47 +78,77 @@ void SpellTextEdit::contextMenuEvent(QContextMenuEvent *event)
     int end = zeile.indexOf(QRegExp("\\W+"),pos);
     int begin = zeile.lastIndexOf(QRegExp("\\W+"),pos);
     zeile=zeile.mid(begin+1,end-begin-1);
-    QStringList liste = getWordPropositions(zeile);
-    if (!liste.isEmpty())
+    // a busy dictionary leaves the word pending rather than holding up the menu
+    bool correct = true;
+    const bool known = dictionary && !zeile.isEmpty() && dictionary->trySpell(zeile, correct);
+    if (dictionary && !zeile.isEmpty() && (!known || !correct))
     {
-        menu->addSeparator();
-        menu->addAction(tr("Add .."), this, SLOT(slot_addWord()));
-        menu->addAction(tr("Ignore .."), this, SLOT(slot_ignoreWord()));
-        for (int i = 0; i < qMin(int(MaxWords),liste.size()); ++i) {
-            misspelledWordsActs[i]->setText(liste.at(i).trimmed());
-            misspelledWordsActs[i]->setVisible(true);
-            menu->addAction(misspelledWordsActs[i]);
+        QAction *separator = menu->addSeparator();
+        QAction *add = menu->addAction(tr("Add .."), this, SLOT(slot_addWord()));
+        QAction *ignore = menu->addAction(tr("Ignore .."), this, SLOT(slot_ignoreWord()));
+
+        // suggestions can take a while, don't hold up the menu for them
+        QStringList liste;
+        if (known && dictionary->isSuggestionCached(zeile, liste))
+            addSuggestions(menu, 0, liste);
+        else
+        {
+            pendingMenu = menu;
+            pendingWord = zeile;
+            pendingActions = known ? QList<QAction *>() : QList<QAction *>({separator, add, ignore});
+            pendingPlaceholder = menu->addAction(known ? tr("Looking up suggestions...") : tr("Checking spelling..."));
+            pendingPlaceholder->setEnabled(false);
+            emit suggest(zeile);
         }
-
-    } // if  misspelled
+    } // if  misspelled or not known yet
     menu->exec(event->globalPos());
+    pendingMenu = 0;
+    pendingActions.clear();
     delete menu;
 }
 
+void SpellTextEdit::slot_suggested(const QString &word, bool correct, const QStringList &suggestions)
+{
+    if (!pendingMenu || !pendingPlaceholder || word != pendingWord)
+        return;
+
+    if (correct)
+    {
+        // the word was only pending, nothing to offer
+        for (QAction *action : pendingActions)
+            pendingMenu->removeAction(action);
+        pendingMenu->removeAction(pendingPlaceholder);
+        pendingActions.clear();
+        pendingMenu = 0;
+        return;
+    }
+
+    addSuggestions(pendingMenu, pendingPlaceholder, suggestions);
+    pendingActions.clear();
+
+    if (suggestions.isEmpty())
+        pendingPlaceholder->setText(tr("No suggestions"));
+    else
+        pendingMenu->removeAction(pendingPlaceholder);
+
+    pendingMenu = 0;
+}
+
+void SpellTextEdit::addSuggestions(QMenu *menu, QAction *before, const QStringList &suggestions)
+{
+    for (int i = 0; i < qMin(int(MaxWords),suggestions.size()); ++i) {
+        misspelledWordsActs[i]->setText(suggestions.at(i).trimmed());
+        misspelledWordsActs[i]->setVisible(true);
+        menu->insertAction(before, misspelledWordsActs[i]);
+    }
+}
+
 QStringList SpellTextEdit::getWordPropositions(const QString word)
 {
     QStringList wordList;
-    if(pChecker){
-        QByteArray encodedString;
-        QString spell_encoding=QString(pChecker->get_dic_encoding());
-        QTextCodec *codec = QTextCodec::codecForName(spell_encoding.toLatin1());
-        encodedString = codec->fromUnicode(word);
-        bool check = pChecker->spell(encodedString.data());
-        if(!check){
-            char ** wlst;
-            int ns = pChecker->suggest(&wlst,encodedString.data());
-            if (ns > 0)
-            {
-                for (int i=0; i < ns; i++)
-                {
-                    wordList.append(codec->toUnicode(wlst[i]));
-                    //free(wlst[i]);
-                }
-                //free(wlst);
-                pChecker->free_list(&wlst, ns);
-            }// if ns >0
-        }// if check
-    }
+    if(dictionary && !dictionary->spell(word))
+        wordList = dictionary->suggest(word);
+
     return wordList;
 }
 
@@ -195,13 +160,8 @@ void SpellTextEdit::slot_addWord()
     int end = zeile.indexOf(QRegExp("\\W+"),pos);
     int begin = zeile.left(pos).lastIndexOf(QRegExp("\\W+"),pos);
     zeile=zeile.mid(begin+1,end-begin-1);
-    //    std::cout << qPrintable(zeile) << std::endl;
-    QByteArray encodedString;
-    QString spell_encoding=QString(pChecker->get_dic_encoding());
-    QTextCodec *codec = QTextCodec::codecForName(spell_encoding.toLatin1());
-    encodedString = codec->fromUnicode(zeile);
-    pChecker->add(encodedString.data());
-    addedWords.append(zeile);
+    if(dictionary)
+        dictionary->add(zeile);
     emit addWord(zeile);
 }
 
@@ -213,10 +173,7 @@ void SpellTextEdit::slot_ignoreWord()
     int end = zeile.indexOf(QRegExp("\\W+"),pos);
     int begin = zeile.left(pos).lastIndexOf(QRegExp("\\W+"),pos);
     zeile=zeile.mid(begin+1,end-begin-1);
-    QByteArray encodedString;
-    QString spell_encoding=QString(pChecker->get_dic_encoding());
-    QTextCodec *codec = QTextCodec::codecForName(spell_encoding.toLatin1());
-    encodedString = codec->fromUnicode(zeile);
-    pChecker->add(encodedString.data());
+    if(dictionary)
+        dictionary->ignore(zeile);
     emit addWord(zeile);
 }
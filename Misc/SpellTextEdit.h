@@ -4,7 +4,12 @@
 #include <QTextEdit>
 #include <QAction>
 #include <QContextMenuEvent>
-#include "hunspell/hunspell.hxx"
+#include <QSharedPointer>
+#include <QPointer>
+#include <QMenu>
+
+class CDictionary;
+class CSpellChecker;
 //#include "settingaspell.h"
 
 class SpellTextEdit : public QTextEdit
@@ -19,6 +24,7 @@ public:
 
 signals:
 	void addWord(QString word);
+	void suggest(const QString &word);
 
 protected:
 	void createActions();
@@ -28,17 +34,24 @@ private slots:
 	void correctWord();
 	void slot_addWord();
 	void slot_ignoreWord();
+	void slot_suggested(const QString &word, bool correct, const QStringList &suggestions);
 
 private:
     enum { MaxWords = 5 };
     QAction *misspelledWordsActs[MaxWords];
 
-    QString spell_dic;
-    Hunspell *pChecker;
+    void addSuggestions(QMenu *menu, QAction *before, const QStringList &suggestions);
 
-    QPoint lastPos;
+    QSharedPointer<CDictionary> dictionary;
+    CSpellChecker *checker;
 
-    QStringList addedWords;
+    // context menu waiting for suggestions
+    QPointer<QMenu> pendingMenu;
+    QPointer<QAction> pendingPlaceholder;
+    QList<QAction *> pendingActions;    // spelling entries, dropped if the word is correct
+    QString pendingWord;
+
+    QPoint lastPos;
 };
 
 #endif /*SPELLTEXTEDIT_H_*/
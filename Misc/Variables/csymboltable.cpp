@@ -0,0 +1,360 @@
+#include "csymboltable.h"
+
+#include <algorithm>
+
+#include "cgraphicsscene.h"
+#include "Bubbles/cstorybubble.h"
+#include "Bubbles/cchoicebubble.h"
+#include "Bubbles/cchoice.h"
+#include "Bubbles/cactionbubble.h"
+#include "Bubbles/cconditionbubble.h"
+#include "Bubbles/ccodebubble.h"
+#include "Bubbles/cstartherebubble.h"
+#include "Misc/Bubbles/cchoicemodel.h"
+#include "Misc/Bubbles/cstartheremodel.h"
+#include "Misc/cstringlistmodel.h"
+#include "Misc/cslexer.h"
+
+
+CSymbolTable::CSymbolTable(QObject *parent)
+    : QObject(parent)
+{}
+
+void CSymbolTable::AddBubble(CBubble *bubble)
+{
+    connect(bubble, SIGNAL(TextChanged()), this, SLOT(BubbleChanged()), Qt::UniqueConnection);
+    connect(bubble, SIGNAL(destroyed(QObject*)), this, SLOT(BubbleDestroyed(QObject*)), Qt::UniqueConnection);
+
+    m_dirty.insert(bubble);
+}
+
+void CSymbolTable::RemoveBubble(CBubble *bubble)
+{
+    disconnect(bubble, SIGNAL(TextChanged()), this, SLOT(BubbleChanged()));
+    disconnect(bubble, SIGNAL(destroyed(QObject*)), this, SLOT(BubbleDestroyed(QObject*)));
+
+    m_dirty.remove(bubble);
+    Unindex(bubble);
+}
+
+void CSymbolTable::BubbleChanged()
+{
+    CBubble *bubble = qobject_cast<CBubble *>(sender());
+    if(bubble)
+        m_dirty.insert(bubble);
+}
+
+void CSymbolTable::BubbleDestroyed(QObject *object)
+{
+    // only used as a key, the bubble is already gone
+    CBubble *bubble = static_cast<CBubble *>(object);
+
+    m_dirty.remove(bubble);
+    Unindex(bubble);
+}
+
+/**
+ * @brief Every place name is used, optionally limited to a single scene.
+ */
+QList<CSymbolTable::Usage> CSymbolTable::usages(const QString &name, CGraphicsScene *scene)
+{
+    Flush();
+
+    QList<Usage> lst = m_usages.value(name);
+    if(scene)
+    {
+        for(int i = lst.length() - 1; i >= 0; --i)
+            if(lst.at(i).bubble->scene() != scene)
+                lst.removeAt(i);
+    }
+
+    return lst;
+}
+
+int CSymbolTable::reads(const QString &name)
+{
+    Flush();
+    return m_reads.value(name);
+}
+
+int CSymbolTable::writes(const QString &name)
+{
+    Flush();
+    return m_writes.value(name);
+}
+
+/**
+ * @brief Replaces every use of name with newName, only touching the fields that use it.
+ */
+void CSymbolTable::Rename(const QString &name, const QString &newName, CGraphicsScene *scene)
+{
+    if(name.isEmpty() || name == newName)
+        return;
+
+    QList<Usage> lst = usages(name, scene);
+
+    // group the spans of each field, last span first so the earlier positions stay valid
+    std::sort(lst.begin(), lst.end(), [](const Usage &a, const Usage &b) {
+        if(a.bubble != b.bubble)
+            return a.bubble < b.bubble;
+        if(a.field != b.field)
+            return a.field < b.field;
+        if(a.index != b.index)
+            return a.index < b.index;
+        return a.start > b.start;
+    });
+
+    int i = 0;
+    while(i < lst.length())
+    {
+        const Usage &first = lst.at(i);
+        QString text = Text(first.bubble, first.field, first.index);
+
+        int j = i;
+        for(; j < lst.length() && lst.at(j).bubble == first.bubble &&
+            lst.at(j).field == first.field && lst.at(j).index == first.index; ++j)
+        {
+            const Usage &u = lst.at(j);
+            if(text.midRef(u.start, u.length) == name)
+                text.replace(u.start, u.length, newName);
+        }
+
+        setText(first.bubble, first.field, first.index, text);
+        i = j;
+    }
+}
+
+QString CSymbolTable::Text(CBubble *bubble, Field field, int index)
+{
+    switch(field)
+    {
+    case Story:
+        return static_cast<CStoryBubble *>(bubble)->getStory();
+    case Choice:
+    {
+        CChoice *choice = static_cast<CChoiceBubble *>(bubble)->choiceBubbles().value(index);
+        return choice ? choice->text() : QString();
+    }
+    case Action:
+        return static_cast<CActionBubble *>(bubble)->actions()->stringList().value(index);
+    case Condition:
+        return static_cast<CConditionBubble *>(bubble)->getCondition();
+    case Code:
+        return static_cast<CCodeBubble *>(bubble)->getCode();
+    case StartHere:
+    {
+        CStartHereModel *model = static_cast<CStartHereBubble *>(bubble)->model();
+        return model->data(model->index(index, 0), Qt::EditRole).toString();
+    }
+    case StartHereCode:
+        return static_cast<CStartHereBubble *>(bubble)->customCode();
+    }
+
+    return QString();
+}
+
+void CSymbolTable::setText(CBubble *bubble, Field field, int index, const QString &text)
+{
+    switch(field)
+    {
+    case Story:
+        static_cast<CStoryBubble *>(bubble)->setStory(text);
+        break;
+    case Choice:
+    {
+        CChoiceModel *model = static_cast<CChoiceBubble *>(bubble)->choices();
+        model->setData(model->index(index), text, Qt::EditRole);
+        break;
+    }
+    case Action:
+    {
+        CStringListModel *model = static_cast<CActionBubble *>(bubble)->actions();
+        model->setData(model->index(index), text);
+        break;
+    }
+    case Condition:
+        static_cast<CConditionBubble *>(bubble)->setCondition(text);
+        break;
+    case Code:
+        static_cast<CCodeBubble *>(bubble)->setCode(text);
+        break;
+    case StartHere:
+    {
+        CStartHereModel *model = static_cast<CStartHereBubble *>(bubble)->model();
+        model->setData(model->index(index, 0), text, Qt::EditRole);
+        break;
+    }
+    case StartHereCode:
+        static_cast<CStartHereBubble *>(bubble)->setCustomCode(text);
+        break;
+    }
+}
+
+void CSymbolTable::Flush()
+{
+    for(CBubble *bubble : m_dirty)
+    {
+        Unindex(bubble);
+        Index(bubble);
+    }
+
+    m_dirty.clear();
+}
+
+void CSymbolTable::Index(CBubble *bubble)
+{
+    switch(bubble->getType())
+    {
+    case Chronicler::StoryBubble:
+        IndexText(bubble, Story, 0, static_cast<CStoryBubble *>(bubble)->getStory());
+        break;
+
+    case Chronicler::ChoiceBubble:
+    {
+        const CChoiceBubble::choiceList choices = static_cast<CChoiceBubble *>(bubble)->choiceBubbles();
+        for(int i = 0; i < choices.length(); ++i)
+            IndexText(bubble, Choice, i, choices.at(i)->text());
+        break;
+    }
+
+    case Chronicler::ActionBubble:
+    {
+        const QStringList actions = static_cast<CActionBubble *>(bubble)->actions()->stringList();
+        for(int i = 0; i < actions.length(); ++i)
+            IndexText(bubble, Action, i, actions.at(i));
+        break;
+    }
+
+    case Chronicler::ConditionBubble:
+        // conditions are stored without their command
+        IndexText(bubble, Condition, 0, static_cast<CConditionBubble *>(bubble)->getCondition(), "*if ");
+        break;
+
+    case Chronicler::CodeBubble:
+        IndexText(bubble, Code, 0, static_cast<CCodeBubble *>(bubble)->getCode());
+        break;
+
+    case Chronicler::StartHereBubble:
+    {
+        CStartHereBubble *bbl = static_cast<CStartHereBubble *>(bubble);
+        const QVector<CVariable> &variables = bbl->model()->variables();
+        for(int i = 0; i < variables.length(); ++i)
+        {
+            const QString name = variables.at(i).name();
+            if(name.isEmpty())
+                continue;
+
+            // the starting value of a variable while debugging
+            Usage u = { bubble, StartHere, i, 0, name.length(), Debug };
+            AddUsage(name, u);
+        }
+
+        IndexText(bubble, StartHereCode, 0, bbl->customCode());
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+void CSymbolTable::IndexText(CBubble *bubble, Field field, int index, const QString &text, const QString &prefix)
+{
+    int state = CSLexer::Normal;
+    int lineStart = 0;
+    while(lineStart <= text.length())
+    {
+        int lineEnd = text.indexOf('\n', lineStart);
+        if(lineEnd == -1)
+            lineEnd = text.length();
+
+        // the prefix only completes the first line for the lexer
+        const int shift = (lineStart == 0) ? lineStart - prefix.length() : lineStart;
+        const QString line = (lineStart == 0) ? prefix + text.left(lineEnd) : text.mid(lineStart, lineEnd - lineStart);
+
+        const QVector<CSLexer::Token> tokens = CSLexer::Tokenize(line, state);
+        for(int i = 0; i < tokens.length(); ++i)
+        {
+            const CSLexer::Token &token = tokens.at(i);
+            if(token.type != CSLexer::Identifier && token.type != CSLexer::Variable)
+                continue;
+
+            const QString name = CSLexer::VariableName(line, token);
+            const int start = (token.type == CSLexer::Variable) ? line.indexOf('{', token.start) + 1 : token.start;
+            if(start + shift < 0)
+                continue;
+
+            // the variable right after an assigning command
+            Access access = Read;
+            if(i == 1 && tokens.at(0).type == CSLexer::Command && token.type == CSLexer::Identifier)
+            {
+                static const QStringList writing = { "*set", "*input_text", "*input_number", "*rand", "*create", "*temp" };
+                static const QStringList modifying = { "+", "-", "*", "/", "%", "%+", "%-", "&" };
+
+                const QString command = line.mid(tokens.at(0).start, tokens.at(0).length);
+                if(writing.contains(command))
+                    access = Write;
+
+                // *set x +1 changes the current value
+                if(command == "*set" && i + 1 < tokens.length() && tokens.at(i + 1).type == CSLexer::Operator &&
+                   modifying.contains(line.mid(tokens.at(i + 1).start, tokens.at(i + 1).length)))
+                    access = ReadWrite;
+            }
+
+            Usage u = { bubble, field, index, start + shift, name.length(), access };
+            AddUsage(name, u);
+        }
+
+        lineStart = lineEnd + 1;
+    }
+}
+
+void CSymbolTable::AddUsage(const QString &name, const Usage &usage)
+{
+    m_usages[name].append(usage);
+    m_bubbleNames[usage.bubble].append(name);
+
+    Count(name, usage.access, 1);
+}
+
+void CSymbolTable::Unindex(CBubble *bubble)
+{
+    QStringList names = m_bubbleNames.take(bubble);
+    names.removeDuplicates();
+
+    for(const QString &name : names)
+    {
+        QHash<QString, QList<Usage>>::iterator it = m_usages.find(name);
+        if(it == m_usages.end())
+            continue;
+
+        QList<Usage> &lst = it.value();
+        for(int i = lst.length() - 1; i >= 0; --i)
+        {
+            if(lst.at(i).bubble == bubble)
+            {
+                Count(name, lst.at(i).access, -1);
+                lst.removeAt(i);
+            }
+        }
+
+        if(lst.isEmpty())
+            m_usages.erase(it);
+    }
+}
+
+// debug values are neither read nor written by the story
+void CSymbolTable::Count(const QString &name, Access access, int delta)
+{
+    if(access == Write || access == ReadWrite)
+    {
+        if((m_writes[name] += delta) <= 0)
+            m_writes.remove(name);
+    }
+
+    if(access == Read || access == ReadWrite)
+    {
+        if((m_reads[name] += delta) <= 0)
+            m_reads.remove(name);
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef CSYMBOLTABLE_H
+#define CSYMBOLTABLE_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QList>
+#include <QStringList>
+
+class CBubble;
+class CGraphicsScene;
+
+
+/**
+ * @brief Inverted index of every name used in the bubbles of the project.
+ * Scenes register their bubbles, a bubble is re-lexed only after its text
+ * changed and only once somebody asks for usages.
+ * The first variable of *set, *input_text, *input_number, *rand, *create and *temp
+ * is counted as a write, every other use as a read. A *set followed by an operator,
+ * e.g. *set x +1, both reads and writes, and the starting values of start here
+ * bubbles are only used while debugging and count as neither.
+ */
+class CSymbolTable : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Field { Story, Choice, Action, Condition, Code, StartHere, StartHereCode };
+    enum Access { Read, Write, ReadWrite, Debug };
+
+    struct Usage
+    {
+        CBubble *bubble;
+        Field field;
+        int index;      // row of the choice, action or start here variable
+        int start;      // position of the name in the text of the field
+        int length;
+        Access access;
+    };
+
+    explicit CSymbolTable(QObject *parent = Q_NULLPTR);
+
+    void AddBubble(CBubble *bubble);
+    void RemoveBubble(CBubble *bubble);
+
+    QList<Usage> usages(const QString &name, CGraphicsScene *scene = Q_NULLPTR);
+    int reads(const QString &name);
+    int writes(const QString &name);
+
+    void Rename(const QString &name, const QString &newName, CGraphicsScene *scene = Q_NULLPTR);
+
+    static QString Text(CBubble *bubble, Field field, int index);
+    static void setText(CBubble *bubble, Field field, int index, const QString &text);
+
+private:
+    void Flush();
+    void Index(CBubble *bubble);
+    void Unindex(CBubble *bubble);
+    void IndexText(CBubble *bubble, Field field, int index, const QString &text, const QString &prefix = "");
+    void AddUsage(const QString &name, const Usage &usage);
+    void Count(const QString &name, Access access, int delta);
+
+    QHash<QString, QList<Usage>> m_usages;
+    QHash<QString, int> m_reads;
+    QHash<QString, int> m_writes;
+    QHash<CBubble *, QStringList> m_bubbleNames;
+    QSet<CBubble *> m_dirty;
+
+private slots:
+    void BubbleChanged();
+    void BubbleDestroyed(QObject *object);
+};
+
+#endif // CSYMBOLTABLE_H
@@ -16,35 +16,27 @@ CVariable::CVariable(QString name, QString data, CGraphicsScene *scene)
     : m_name(name), m_data(data), m_scene(scene)
 {}
 
-CVariable::~CVariable()
-{}
-
-bool CVariable::operator ==(const CVariable &rhs)
+bool CVariable::operator ==(const CVariable &rhs) const
 {
     return m_name == rhs.m_name && m_data == rhs.m_data && m_scene == rhs.m_scene;
 }
 
 
-QDataStream &CVariable::Deserialize(QDataStream &ds, const CVersion &version)
+QDataStream &operator >>(QDataStream &ds, CVariable &variable)
 {
-    Q_UNUSED(version)
-
-    QString sceneName;
-    ds >> sceneName;
-    if(sceneName.length())
-        m_scene = shared().projectView->model()->sceneWithName(sceneName);
+    QString sceneName, name, data;
+    ds >> sceneName >> name >> data;
 
-    return ds >> m_name >> m_data;
-}
+    variable.setScene(sceneName.length() ? shared().projectView->model()->sceneWithName(sceneName) : Q_NULLPTR);
+    variable.setName(name);
+    variable.setData(data);
 
-QDataStream &CVariable::Serialize(QDataStream &ds) const
-{
-    return ds << (m_scene ? m_scene->name() : QString()) << m_name << m_data;
+    return ds;
 }
 
-CGraphicsScene *CVariable::scene() const
+QDataStream &operator <<(QDataStream &ds, const CVariable &variable)
 {
-    return m_scene;
+    return ds << (variable.scene() ? variable.scene()->name() : QString()) << variable.name() << variable.data();
 }
 
 void CVariable::setScene(CGraphicsScene *scene)
@@ -52,21 +44,11 @@ void CVariable::setScene(CGraphicsScene *scene)
     m_scene = scene;
 }
 
-QString CVariable::data() const
-{
-    return m_data;
-}
-
 void CVariable::setData(const QString &data)
 {
     m_data = data;
 }
 
-QString CVariable::name() const
-{
-    return m_name;
-}
-
 void CVariable::setName(const QString &name)
 {
     m_name = name;
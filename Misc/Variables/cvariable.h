@@ -1,35 +1,31 @@
 #ifndef CVARIABLE_H
 #define CVARIABLE_H
 
-#include "Misc/cserializable.h"
+#include <QString>
+#include <QDataStream>
 
 class CGraphicsScene;
 
-class CVariable : public CSerializable
+/**
+ * @brief Plain value type, stored contiguously by the variable models.
+ */
+class CVariable
 {
 public:
     CVariable();
     CVariable(QString name, QString data, CGraphicsScene *scene);
 
-    virtual ~CVariable();
+    bool operator ==(const CVariable &rhs) const;
 
-    bool operator ==(const CVariable &rhs);
-
-    QString name() const;
+    QString name() const { return m_name; }
     void setName(const QString &name);
 
-    QString data() const;
+    QString data() const { return m_data; }
     void setData(const QString &data);
 
-    CGraphicsScene *scene() const;
+    CGraphicsScene *scene() const { return m_scene; }
     void setScene(CGraphicsScene *scene);
 
-
-
-protected:
-    virtual QDataStream &Deserialize(QDataStream &ds, const CVersion &version) Q_DECL_OVERRIDE;
-    virtual QDataStream &Serialize(QDataStream &ds) const Q_DECL_OVERRIDE;
-
 private:
     QString m_name;
     QString m_data;
@@ -37,4 +33,9 @@ private:
     CGraphicsScene *m_scene;
 };
 
+Q_DECLARE_TYPEINFO(CVariable, Q_MOVABLE_TYPE);
+
+QDataStream &operator <<(QDataStream &ds, const CVariable &variable);
+QDataStream &operator >>(QDataStream &ds, CVariable &variable);
+
 #endif // CVARIABLE_H
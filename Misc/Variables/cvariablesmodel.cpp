@@ -4,23 +4,14 @@
 
 #include "Properties/cprojectview.h"
 #include "Misc/cscenemodel.h"
-#include "cgraphicsview.h"
 #include "cgraphicsscene.h"
-#include "Bubbles/cstorybubble.h"
-#include "Bubbles/cchoicebubble.h"
-#include "Bubbles/cchoice.h"
-#include "Bubbles/cactionbubble.h"
-#include "Misc/cstringlistmodel.h"
-#include "Bubbles/cconditionbubble.h"
-#include "Bubbles/ccodebubble.h"
-#include "Bubbles/cstartherebubble.h"
-#include "Misc/Bubbles/cstartheremodel.h"
+#include "Misc/Variables/csymboltable.h"
 
 #include "Misc/chronicler.h"
 using Chronicler::shared;
 
 CVariablesModel::CVariablesModel(QObject *parent)
-    : QAbstractTableModel(parent)
+    : QAbstractTableModel(parent), m_namesDirty(true)
 {}
 
 
@@ -87,7 +78,9 @@ QVariant CVariablesModel::data(const QModelIndex &index, int role) const
                 if(role == Qt::EditRole)
                 {
                     RefactorBubbles(m_variables[index.row()], variant.toString());
+                    UnindexRow(index.row());
                     m_variables[index.row()].setName(variant.toString());
+                    IndexRow(index.row());
 
                     emit dataChanged(index, index, {Qt::EditRole, Qt::DisplayRole});
                     return true;
@@ -136,114 +129,100 @@ QVariant CVariablesModel::data(const QModelIndex &index, int role) const
 
         beginInsertRows(QModelIndex(), row, row);
         m_variables.append(item);
+        IndexRow(row);
         endInsertRows();
     }
 
     void CVariablesModel::RemoveItem(const CVariable &item)
     {
-        int row = m_variables.indexOf(item);
-
-        beginRemoveRows(QModelIndex(), row, row);
-        m_variables.removeAll(item);
-        endRemoveRows();
+        const int row = m_variables.indexOf(item);
+        if(row != -1)
+            removeRows(row, 1);
     }
 
     void CVariablesModel::Reset()
     {
         beginResetModel();
         m_variables.clear();
+        m_namesDirty = true;
         endResetModel();
     }
 
-    QList<CVariable> CVariablesModel::variables() const
+    const QVector<CVariable> &CVariablesModel::variables() const
     {
         return m_variables;
     }
 
-    void CVariablesModel::RefactorBubbles(const CVariable &current, QString newName)
+    const QSet<QString> &CVariablesModel::names() const
+    {
+        UpdateNames();
+        return m_names;
+    }
+
+    /**
+     * @brief Whether an identical variable exists, only the rows sharing its name are compared.
+     */
+    bool CVariablesModel::contains(const CVariable &variable) const
+    {
+        UpdateNames();
+
+        for(int row : m_rows.value(variable.name()))
+            if(m_variables.at(row) == variable)
+                return true;
+
+        return false;
+    }
+
+    void CVariablesModel::UpdateNames() const
     {
-        if(current.name().length())
+        if(m_namesDirty)
         {
-            for(CGraphicsView *view : shared().projectView->model()->views())
-            {
-                // if global, replace everywhere, else replace only in local scene
-                if(!current.scene() || current.scene() == view->cScene())
-                {
-                    for(CBubble *b : view->cScene()->bubbles())
-                    {
-                        if(b->getType() == Chronicler::StoryBubble)
-                        {
-                            CStoryBubble *bbl = static_cast<CStoryBubble *>(b);
-                            bbl->setStory(bbl->getStory().replace("${" + current.name() + "}", "${" + newName + "}"));
-                        }
-                        else if(b->getType() == Chronicler::ChoiceBubble)
-                        {
-                            CChoiceBubble *bbl = static_cast<CChoiceBubble *>(b);
-                            for(CChoice *choice : bbl->choiceBubbles())
-                                choice->setChoice(choice->text().replace("${" + current.name() + "}", "${" + newName + "}"));
-                        }
-                        else if(b->getType() == Chronicler::ActionBubble)
-                        {
-                            CActionBubble *bbl = static_cast<CActionBubble *>(b);
-                            QStringList actions = bbl->actions()->stringList();
-                            for(int i = 0; i < actions.length(); ++i)
-                            {
-                                QString a = actions.at(i);
-                                int space = a.indexOf(QRegularExpression("\\s"));
-
-                                actions.replace(i, a.left(space) + a.mid(space).replace(current.name(), newName));
-                            }
-
-                            bbl->actions()->setStringList(actions);
-                        }
-                        else if(b->getType() == Chronicler::ConditionBubble)
-                        {
-                            CConditionBubble *bbl = static_cast<CConditionBubble *>(b);
-                            bbl->setCondition(bbl->getCondition().replace(current.name(), newName));
-                        }
-                        else if(b->getType() == Chronicler::CodeBubble)
-                        {
-                            CCodeBubble *bbl = static_cast<CCodeBubble *>(b);
-                            QString code = bbl->getCode();
-
-                            QRegularExpression action("\\*\\w+");
-                            QRegularExpression white_space("\\s|\\n");
-
-                            int start = 0;
-                            int end = code.indexOf(white_space);
-                            int diff = end;
-                            QString token = code.left(end);
-
-                            while(end != -1)
-                            {
-                                if(!action.match(token).hasMatch() && token.contains(current.name()))
-                                    code.replace(start, diff, code.mid(start, diff).replace(current.name(), newName));
-
-                                start = end + 1;
-                                end = code.indexOf(white_space, start);
-                                diff = end - start;
-                                token = code.mid(start, diff);
-                            }
-
-                            bbl->setCode(code);
-                        }
-                        else if(b->getType() == Chronicler::StartHereBubble)
-                        {
-                            CStartHereBubble *bbl = static_cast<CStartHereBubble *>(b);
-                            CStartHereModel *model = bbl->model();
-                            for(int i = 0; i < model->variables().length(); ++i)
-                            {
-                                QModelIndex ix = model->index(i, 0);
-                                if(model->data(ix, Qt::EditRole).toString() == current.name())
-                                    model->setData(ix, newName, Qt::EditRole);
-                            }
-                        }
-                    }
-                }
-            }
+            m_names.clear();
+            m_rows.clear();
+            m_names.reserve(m_variables.length());
+            m_rows.reserve(m_variables.length());
+
+            m_namesDirty = false;
+            for(int i = 0; i < m_variables.length(); ++i)
+                IndexRow(i);
         }
     }
 
+    void CVariablesModel::IndexRow(int row) const
+    {
+        if(m_namesDirty)
+            return;
+
+        const QString &name = m_variables.at(row).name();
+        m_rows[name].append(row);
+        m_names.insert(name);
+    }
+
+    void CVariablesModel::UnindexRow(int row) const
+    {
+        if(m_namesDirty)
+            return;
+
+        const QString &name = m_variables.at(row).name();
+        QHash<QString, QVector<int>>::iterator it = m_rows.find(name);
+        if(it == m_rows.end())
+            return;
+
+        it.value().removeOne(row);
+        if(it.value().isEmpty())
+        {
+            m_rows.erase(it);
+            m_names.remove(name);
+        }
+    }
+
+    void CVariablesModel::RefactorBubbles(const CVariable &current, QString newName)
+    {
+        // if global, replace everywhere, else replace only in local scene
+        if(current.name().length() && shared().symbolTable)
+            shared().symbolTable->Rename(current.name(), newName, current.scene());
+    }
+
 
     bool CVariablesModel::removeRows(int row, int count, const QModelIndex &parent)
     {
@@ -252,16 +231,28 @@ QVariant CVariablesModel::data(const QModelIndex &index, int role) const
         beginRemoveRows(QModelIndex(), row, row + count - 1);
 
         for(int i = row; i < row + count; ++i)
-            m_variables.removeAt(i);
+            UnindexRow(i);
+
+        m_variables.remove(row, count);
+
+        // shift the rows after the removed ones
+        if(!m_namesDirty)
+        {
+            for(QHash<QString, QVector<int>>::iterator it = m_rows.begin(); it != m_rows.end(); ++it)
+                for(int &r : it.value())
+                    if(r >= row + count)
+                        r -= count;
+        }
 
         endRemoveRows();
 
         return true;
     }
 
-    void CVariablesModel::setVariables(const QList<CVariable> &variables)
+    void CVariablesModel::setVariables(const QVector<CVariable> &variables)
     {
         beginResetModel();
         m_variables = variables;
+        m_namesDirty = true;
         endResetModel();
     }
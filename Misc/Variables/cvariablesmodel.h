@@ -2,6 +2,9 @@
 #define CVARIABLESMODEL_H
 
 #include <QAbstractTableModel>
+#include <QSet>
+#include <QHash>
+#include <QVector>
 
 #include "Misc/Variables/cvariable.h"
 
@@ -20,18 +23,29 @@ public:
 
     virtual bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) Q_DECL_OVERRIDE;
 
-    void setVariables(const QList<CVariable> &variables);
+    void setVariables(const QVector<CVariable> &variables);
     void AddItem(const CVariable &item);
     void RemoveItem(const CVariable &item);
 
     void Reset();
 
-    QList<CVariable> variables() const;
+    const QVector<CVariable> &variables() const;
+    const QSet<QString> &names() const;
+    bool contains(const CVariable &variable) const;
 
 private:
     void RefactorBubbles(const CVariable &current, QString newName);
 
-    QList<CVariable> m_variables;
+    QVector<CVariable> m_variables;
+
+    // name lookups, kept up to date by edits and only rebuilt after a reset
+    void UpdateNames() const;
+    void IndexRow(int row) const;
+    void UnindexRow(int row) const;
+
+    mutable QSet<QString> m_names;
+    mutable QHash<QString, QVector<int>> m_rows;   // every row using a name, variables may share one across scenes
+    mutable bool m_namesDirty;
 
 };
 
@@ -0,0 +1,183 @@
+#include "ccompletionindex.h"
+
+#include <algorithm>
+
+QHash<QString, int> CCompletionIndex::m_frequencies;
+quint64 CCompletionIndex::m_frequencyRevision = 0;
+
+
+CCompletionIndex::CCompletionIndex()
+{
+    Clear();
+}
+
+void CCompletionIndex::Clear()
+{
+    m_completions.clear();
+    m_nodes.clear();
+    m_rankedRevision = m_frequencyRevision;
+
+    Node root = { QChar(), -1, -1, QVector<int>() };
+    m_nodes.append(root);
+}
+
+void CCompletionIndex::Build(const QStringList &completions)
+{
+    Clear();
+
+    m_completions = completions;
+    m_completions.removeDuplicates();
+
+    for(const QString &completion : m_completions)
+        for(const QString &key : Keys(completion))
+            Insert(key);
+
+    Rank();
+}
+
+/**
+ * @brief The lower case completion and every word in it following a symbol, e.g. *goto or choice_is_web.
+ */
+QStringList CCompletionIndex::Keys(const QString &completion)
+{
+    const QString key = completion.toLower();
+
+    QStringList keys;
+    keys.append(key);
+    for(int j = 1; j < key.length(); ++j)
+    {
+        if(key.at(j).isLetterOrNumber() && !key.at(j - 1).isLetterOrNumber())
+            keys.append(key.mid(j));
+    }
+
+    return keys;
+}
+
+void CCompletionIndex::Insert(const QString &key)
+{
+    int node = 0;
+    for(const QChar &c : key)
+    {
+        int child = Child(node, c);
+        if(child == -1)
+        {
+            Node n = { c, -1, m_nodes[node].child, QVector<int>() };
+            child = m_nodes.length();
+            m_nodes.append(n);
+            m_nodes[node].child = child;
+        }
+
+        node = child;
+    }
+}
+
+/**
+ * @brief Fills the best ranked completions of every node, walking the completions
+ * from best to worst so each node takes the first ones that reach it.
+ */
+void CCompletionIndex::Rank()
+{
+    QVector<int> order(m_completions.length());
+    for(int i = 0; i < order.length(); ++i)
+        order[i] = i;
+
+    QVector<int> frequencies(m_completions.length());
+    for(int i = 0; i < frequencies.length(); ++i)
+        frequencies[i] = m_frequencies.value(m_completions.at(i));
+
+    std::sort(order.begin(), order.end(), [this, &frequencies](int a, int b) {
+        if(frequencies.at(a) != frequencies.at(b))
+            return frequencies.at(a) > frequencies.at(b);
+
+        return m_completions.at(a).compare(m_completions.at(b), Qt::CaseInsensitive) < 0;
+    });
+
+    for(Node &n : m_nodes)
+        n.top.clear();
+
+    for(int completion : order)
+    {
+        for(const QString &key : Keys(m_completions.at(completion)))
+        {
+            // a completion reaches the nodes shared by its keys more than once
+            int node = 0;
+            for(int i = 0; node != -1; ++i)
+            {
+                QVector<int> &top = m_nodes[node].top;
+                if(top.length() < MaxResults && (top.isEmpty() || top.last() != completion))
+                    top.append(completion);
+
+                node = (i < key.length()) ? Child(node, key.at(i)) : -1;
+            }
+        }
+    }
+
+    m_rankedRevision = m_frequencyRevision;
+}
+
+int CCompletionIndex::Child(int node, const QChar &c) const
+{
+    int child = m_nodes.at(node).child;
+    while(child != -1 && m_nodes.at(child).c != c)
+        child = m_nodes.at(child).next;
+
+    return child;
+}
+
+int CCompletionIndex::FindNode(const QString &prefix) const
+{
+    int node = 0;
+    for(const QChar &c : prefix)
+    {
+        node = Child(node, c);
+        if(node == -1)
+            return -1;
+    }
+
+    return node;
+}
+
+/**
+ * @brief Returns at most max completions starting with prefix,
+ * the most used ones first and alphabetically after that.
+ * The ranking is only redone after a completion was picked.
+ */
+QStringList CCompletionIndex::Find(const QString &prefix, int max)
+{
+    QStringList found;
+
+    if(m_rankedRevision != m_frequencyRevision)
+        Rank();
+
+    const int start = FindNode(prefix.toLower());
+    if(start == -1)
+        return found;
+
+    const QVector<int> &top = m_nodes.at(start).top;
+    const int count = qMin(max, top.length());
+
+    found.reserve(count);
+    for(int i = 0; i < count; ++i)
+        found.append(m_completions.at(top.at(i)));
+
+    return found;
+}
+
+void CCompletionIndex::Used(const QString &completion)
+{
+    ++m_frequencies[completion];
+    ++m_frequencyRevision;
+
+    // keep the history bounded, halving every count lets old picks fade out
+    if(m_frequencies.size() > MaxFrequencies)
+    {
+        for(QHash<QString, int>::iterator it = m_frequencies.begin(); it != m_frequencies.end();)
+        {
+            it.value() /= 2;
+            if(it.value() == 0)
+                it = m_frequencies.erase(it);
+            else
+                ++it;
+        }
+    }
+}
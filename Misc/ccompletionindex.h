@@ -0,0 +1,58 @@
+#ifndef CCOMPLETIONINDEX_H
+#define CCOMPLETIONINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+
+
+/**
+ * @brief Case insensitive prefix trie over a list of completions.
+ * Every completion can also be found by the words it is made of, so "web" finds
+ * "choice_is_web" and "go" finds "*goto". Results are ranked by how often a completion
+ * was picked before, which is shared by every index and bounded in size.
+ * Every node keeps its best ranked completions, so a lookup never walks the subtree.
+ */
+class CCompletionIndex
+{
+public:
+    CCompletionIndex();
+
+    void Build(const QStringList &completions);
+    void Clear();
+
+    QStringList Find(const QString &prefix, int max = MaxResults);
+
+    int count() const { return m_completions.length(); }
+
+    static void Used(const QString &completion);
+
+    static const int MaxResults = 200;
+
+private:
+    struct Node
+    {
+        QChar c;
+        int child;
+        int next;
+        QVector<int> top;   // best ranked completions in the subtree, at most MaxResults
+    };
+
+    void Insert(const QString &key);
+    void Rank();
+    int FindNode(const QString &prefix) const;
+    int Child(int node, const QChar &c) const;
+
+    static QStringList Keys(const QString &completion);
+
+    QVector<Node> m_nodes;
+    QStringList m_completions;
+    quint64 m_rankedRevision;
+
+    static const int MaxFrequencies = 1000;
+    static QHash<QString, int> m_frequencies;
+    static quint64 m_frequencyRevision;
+};
+
+#endif // CCOMPLETIONINDEX_H
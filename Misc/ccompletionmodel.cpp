@@ -0,0 +1,96 @@
+#include "ccompletionmodel.h"
+
+
+CCompletionModel::CCompletionModel(QObject *parent)
+    : QAbstractListModel(parent), m_dirty(true)
+{}
+
+void CCompletionModel::setSource(QStringListModel *source)
+{
+    if(m_source)
+        disconnect(m_source, 0, this, 0);
+
+    m_source = source;
+
+    if(m_source)
+    {
+        connect(m_source, SIGNAL(rowsInserted(QModelIndex,int,int)), this, SLOT(SourceChanged()));
+        connect(m_source, SIGNAL(rowsRemoved(QModelIndex,int,int)), this, SLOT(SourceChanged()));
+        connect(m_source, SIGNAL(rowsMoved(QModelIndex,int,int,QModelIndex,int)), this, SLOT(SourceChanged()));
+        connect(m_source, SIGNAL(layoutChanged()), this, SLOT(SourceChanged()));
+        connect(m_source, SIGNAL(dataChanged(QModelIndex,QModelIndex,QVector<int>)), this, SLOT(SourceChanged()));
+        connect(m_source, SIGNAL(modelReset()), this, SLOT(SourceChanged()));
+    }
+
+    SourceChanged();
+}
+
+void CCompletionModel::SourceChanged()
+{
+    m_dirty = true;
+}
+
+void CCompletionModel::setPrefix(const QString &prefix)
+{
+    if(m_dirty)
+    {
+        if(m_source)
+            m_index.Build(m_source->stringList());
+        else
+            m_index.Clear();
+
+        m_dirty = false;
+    }
+
+    const QStringList completions = m_index.Find(prefix);
+
+    // update the rows in place, only the difference in length is inserted or removed
+    const int common = qMin(m_completions.length(), completions.length());
+    int first = -1, last = -1;
+    for(int i = 0; i < common; ++i)
+    {
+        if(m_completions.at(i) != completions.at(i))
+        {
+            m_completions[i] = completions.at(i);
+            if(first == -1)
+                first = i;
+            last = i;
+        }
+    }
+    if(first != -1)
+        emit dataChanged(index(first), index(last), {Qt::DisplayRole, Qt::EditRole});
+
+    if(completions.length() > m_completions.length())
+    {
+        beginInsertRows(QModelIndex(), common, completions.length() - 1);
+        m_completions.append(completions.mid(common));
+        endInsertRows();
+    }
+    else if(completions.length() < m_completions.length())
+    {
+        beginRemoveRows(QModelIndex(), common, m_completions.length() - 1);
+        m_completions.erase(m_completions.begin() + common, m_completions.end());
+        endRemoveRows();
+    }
+}
+
+QString CCompletionModel::completion(int row) const
+{
+    return m_completions.value(row);
+}
+
+int CCompletionModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    return m_completions.length();
+}
+
+QVariant CCompletionModel::data(const QModelIndex &index, int role) const
+{
+    if(index.isValid() && index.row() < m_completions.length() && (role == Qt::DisplayRole || role == Qt::EditRole))
+        return m_completions.at(index.row());
+
+    return QVariant();
+}
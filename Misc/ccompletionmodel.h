@@ -0,0 +1,42 @@
+#ifndef CCOMPLETIONMODEL_H
+#define CCOMPLETIONMODEL_H
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <QStringListModel>
+
+#include "Misc/ccompletionindex.h"
+
+
+/**
+ * @brief Completions of a source model matching the current prefix.
+ * The source is indexed lazily after it changed, and changing the prefix
+ * only updates the rows that differ instead of resetting the model.
+ */
+class CCompletionModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+public:
+    explicit CCompletionModel(QObject *parent = Q_NULLPTR);
+
+    void setSource(QStringListModel *source);
+
+    void setPrefix(const QString &prefix);
+    QString completion(int row) const;
+
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const Q_DECL_OVERRIDE;
+    virtual QVariant data(const QModelIndex &index, int role) const Q_DECL_OVERRIDE;
+
+private:
+    QPointer<QStringListModel> m_source;
+    CCompletionIndex m_index;
+    bool m_dirty;
+
+    QStringList m_completions;
+
+private slots:
+    void SourceChanged();
+};
+
+#endif // CCOMPLETIONMODEL_H
@@ -0,0 +1,340 @@
+#include "cdictionary.h"
+
+#include <QHash>
+#include <QWeakPointer>
+#include <QMutexLocker>
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+#include <QTextCodec>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QCoreApplication>
+
+#include "hunspell/hunspell.hxx"
+
+
+static QMutex &registryMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+
+static QHash<QString, QWeakPointer<CDictionary>> &registry()
+{
+    static QHash<QString, QWeakPointer<CDictionary>> dictionaries;
+    return dictionaries;
+}
+
+// keeps preloaded dictionaries alive while no editor is open
+static QList<QSharedPointer<CDictionary>> &preloaded()
+{
+    static QList<QSharedPointer<CDictionary>> dictionaries;
+    return dictionaries;
+}
+
+
+class CDictionaryLoader : public QRunnable
+{
+public:
+    explicit CDictionaryLoader(const QString &dicPath)
+        : m_path(dicPath) {}
+
+    virtual void run() Q_DECL_OVERRIDE
+    {
+        QSharedPointer<CDictionary> dictionary = CDictionary::Acquire(m_path);
+
+        QMutexLocker locker(&registryMutex());
+        preloaded().append(dictionary);
+    }
+
+private:
+    QString m_path;
+};
+
+
+CDictionary::CDictionary(const QString &dicPath)
+    : m_path(dicPath.left(dicPath.length() - 4)), m_checker(Q_NULLPTR), m_codec(Q_NULLPTR), m_results(20000), m_suggestions(200)
+{
+    QFileInfo fi(dicPath);
+    if(!(fi.exists() && fi.isReadable()))
+        return;
+
+    m_checker = new Hunspell(QString(m_path + ".aff").toLatin1(), QString(m_path + ".dic").toLatin1());
+    m_codec = QTextCodec::codecForName(m_checker->get_dic_encoding());
+    if(!m_codec)
+        m_codec = QTextCodec::codecForName("UTF-8");
+
+    // merge the user dictionary
+    fi = QFileInfo(UserDictionaryPath());
+    if(fi.exists() && fi.isReadable())
+        m_checker->add_dic(UserDictionaryPath().toLatin1());
+}
+
+CDictionary::~CDictionary()
+{
+    delete m_checker;
+}
+
+/**
+ * @brief Returns the dictionary for dicPath, loading it if nobody else is using it.
+ * Blocks while the same dictionary is still being preloaded.
+ */
+QSharedPointer<CDictionary> CDictionary::Acquire(const QString &dicPath)
+{
+    QMutexLocker locker(&registryMutex());
+
+    QSharedPointer<CDictionary> dictionary = registry().value(dicPath).toStrongRef();
+    if(!dictionary)
+    {
+        dictionary = QSharedPointer<CDictionary>(new CDictionary(dicPath));
+        registry().insert(dicPath, dictionary);
+    }
+
+    return dictionary;
+}
+
+/**
+ * @brief Loads the dictionary in the background so the first editor doesn't have to wait.
+ */
+void CDictionary::Preload(const QString &dicPath)
+{
+    QThreadPool::globalInstance()->start(new CDictionaryLoader(dicPath));
+}
+
+QString CDictionary::defaultPath()
+{
+    return QCoreApplication::applicationDirPath() + "/en_US.dic";
+}
+
+static inline bool isWordChar(const QChar &c)
+{
+    return c.isLetterOrNumber() || c.isMark() || c == '_';
+}
+
+/**
+ * @brief Splits text into the words worth checking in a single pass.
+ * Single letters and words following a backslash (escape sequences) are skipped,
+ * apostrophes between letters are kept so contractions are checked whole.
+ */
+QVector<CDictionary::Word> CDictionary::Words(const QString &text)
+{
+    QVector<Word> words;
+
+    const int length = text.length();
+    int i = 0;
+    while(i < length)
+    {
+        if(!isWordChar(text.at(i)))
+        {
+            ++i;
+            continue;
+        }
+
+        const int start = i;
+        while(i < length && (isWordChar(text.at(i)) ||
+                             (text.at(i) == '\'' && i + 1 < length && isWordChar(text.at(i + 1)))))
+            ++i;
+
+        const int count = i - start;
+        if(count > 1 && !(start > 0 && text.at(start - 1) == '\\'))
+            words.append(Word(start, count));
+    }
+
+    return words;
+}
+
+bool CDictionary::isValid() const
+{
+    return m_checker != Q_NULLPTR;
+}
+
+bool CDictionary::spell(const QString &word)
+{
+    if(!m_checker)
+        return true;
+
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        bool *cached = m_results.object(word);
+        if(cached)
+            return *cached;
+    }
+
+    bool correct;
+    {
+        QMutexLocker locker(&m_checkerMutex);
+        correct = m_checker->spell(Encode(word).data());
+    }
+
+    QMutexLocker locker(&m_cacheMutex);
+    m_results.insert(word, new bool(correct));
+
+    return correct;
+}
+
+// Checks the word only if Hunspell is free, false while the answer is pending
+bool CDictionary::trySpell(const QString &word, bool &correct)
+{
+    if(isCached(word, correct))
+        return true;
+
+    if(!m_checkerMutex.tryLock())
+        return false;
+
+    correct = m_checker->spell(Encode(word).data());
+    m_checkerMutex.unlock();
+
+    QMutexLocker locker(&m_cacheMutex);
+    m_results.insert(word, new bool(correct));
+
+    return true;
+}
+
+// Only looks at the cache, a busy cache counts as not cached
+bool CDictionary::isCached(const QString &word, bool &correct)
+{
+    if(!m_checker)
+    {
+        correct = true;
+        return true;
+    }
+
+    if(!m_cacheMutex.tryLock())
+        return false;
+
+    bool *cached = m_results.object(word);
+    if(cached)
+        correct = *cached;
+
+    m_cacheMutex.unlock();
+
+    return cached != Q_NULLPTR;
+}
+
+QStringList CDictionary::suggest(const QString &word)
+{
+    QStringList suggestions;
+
+    if(m_checker)
+    {
+        {
+            QMutexLocker locker(&m_cacheMutex);
+            QStringList *cached = m_suggestions.object(word);
+            if(cached)
+                return *cached;
+        }
+
+        {
+            QMutexLocker locker(&m_checkerMutex);
+
+            char **list;
+            int count = m_checker->suggest(&list, Encode(word).data());
+            for(int i = 0; i < count; ++i)
+                suggestions.append(m_codec->toUnicode(list[i]));
+            if(count > 0)
+                m_checker->free_list(&list, count);
+        }
+
+        QMutexLocker locker(&m_cacheMutex);
+        m_suggestions.insert(word, new QStringList(suggestions));
+    }
+
+    return suggestions;
+}
+
+// Only looks at the cache, a busy cache counts as not cached
+bool CDictionary::isSuggestionCached(const QString &word, QStringList &suggestions)
+{
+    if(!m_checker)
+        return true;
+
+    if(!m_cacheMutex.tryLock())
+        return false;
+
+    QStringList *cached = m_suggestions.object(word);
+    if(cached)
+        suggestions = *cached;
+
+    m_cacheMutex.unlock();
+
+    return cached != Q_NULLPTR;
+}
+
+void CDictionary::add(const QString &word)
+{
+    if(!m_checker)
+        return;
+
+    {
+        QMutexLocker locker(&m_checkerMutex);
+        m_checker->add(Encode(word).data());
+    }
+
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        m_results.insert(word, new bool(true));
+        if(!m_addedWords.contains(word))
+            m_addedWords.append(word);
+    }
+
+    SaveUserDictionary();
+}
+
+// accepted for the rest of the session only
+void CDictionary::ignore(const QString &word)
+{
+    if(!m_checker)
+        return;
+
+    {
+        QMutexLocker locker(&m_checkerMutex);
+        m_checker->add(Encode(word).data());
+    }
+
+    QMutexLocker locker(&m_cacheMutex);
+    m_results.insert(word, new bool(true));
+}
+
+QByteArray CDictionary::Encode(const QString &word) const
+{
+    return m_codec->fromUnicode(word);
+}
+
+QString CDictionary::UserDictionaryPath() const
+{
+    QSettings setting;
+    return QFileInfo(setting.fileName()).absoluteFilePath() + "/User_" + QFileInfo(m_path + ".dic").fileName();
+}
+
+void CDictionary::SaveUserDictionary()
+{
+    QStringList words;
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        words = m_addedWords;
+    }
+
+    QFile file(UserDictionaryPath());
+    if(file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QTextStream in(&file);
+        in.readLine();
+        while(!in.atEnd())
+        {
+            QString line = in.readLine();
+            if(!words.contains(line))
+                words << line;
+        }
+        file.close();
+    }
+
+    if(file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        QTextStream out(&file);
+        out << words.count() << "\n";
+        for(const QString &word : words)
+            out << Encode(word).data() << "\n";
+    }
+}
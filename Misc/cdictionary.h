@@ -0,0 +1,69 @@
+#ifndef CDICTIONARY_H
+#define CDICTIONARY_H
+
+#include <QString>
+#include <QStringList>
+#include <QSharedPointer>
+#include <QMutex>
+#include <QCache>
+#include <QPair>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QTextCodec;
+QT_END_NAMESPACE
+
+class Hunspell;
+
+
+/**
+ * @brief Hunspell dictionary shared by every spell checking editor and highlighter.
+ * Each dictionary file is only loaded once and lives as long as someone holds on to it.
+ * The user dictionary is merged on load and written back whenever a word is added.
+ * Hunspell calls are serialized and memoized, so a dictionary can be used from worker threads.
+ * The caches have their own lock, the GUI only ever tries it and never waits on Hunspell.
+ */
+class CDictionary
+{
+public:
+    typedef QPair<int, int> Word; // start, length
+
+    ~CDictionary();
+
+    static QSharedPointer<CDictionary> Acquire(const QString &dicPath);
+    static void Preload(const QString &dicPath);
+    static QString defaultPath();
+    static QVector<Word> Words(const QString &text);
+
+    bool isValid() const;
+
+    bool spell(const QString &word);
+    bool trySpell(const QString &word, bool &correct);
+    bool isCached(const QString &word, bool &correct);
+    QStringList suggest(const QString &word);
+    bool isSuggestionCached(const QString &word, QStringList &suggestions);
+
+    void add(const QString &word);
+    void ignore(const QString &word);
+
+private:
+    explicit CDictionary(const QString &dicPath);
+
+    QByteArray Encode(const QString &word) const;
+    QString UserDictionaryPath() const;
+    void SaveUserDictionary();
+
+    QString     m_path;
+    Hunspell   *m_checker;
+    QTextCodec *m_codec;
+    QStringList m_addedWords;
+
+    // results of previous lookups, shared by every highlighter
+    QCache<QString, bool> m_results;
+    QCache<QString, QStringList> m_suggestions;
+
+    QMutex      m_checkerMutex; // Hunspell
+    QMutex      m_cacheMutex;   // results, suggestions and added words
+};
+
+#endif // CDICTIONARY_H
@@ -112,8 +112,11 @@ QList<ChoiceScriptData::CSBlock> ChoiceScriptData::ProcessFile(QFile &file, cons
     QList<CSLine> lines = CSProcLines(stream, csindent);
     QList<CSBlock> blocks = CSProcBlocks(lines);
 
-    QList<CSBubble> deferred = CSProcBubbles(blocks, view->cScene());
-    CSLinkBubbles(deferred, view->cScene());
+    {
+        CGraphicsScene::Batch batch(view->cScene());
+        QList<CSBubble> deferred = CSProcBubbles(blocks, view->cScene());
+        CSLinkBubbles(deferred, view->cScene());
+    }
 
     m_views.append(view);
 
@@ -459,6 +462,7 @@ CBubble * ChoiceScriptData::CSProcBubble(const CSBlock &csblock, QList<CSBubble>
         {
             const CSBlock &choice = csblock.children[i];
             CChoice *cschoice = new CChoice(bbl->getPaletteAction(), bbl->getFont(), bbl, choice.text);
+            cschoice->UpdateUID();
             bbl->choices()->AddItem(cschoice);
 
             bool left = (i < csblock.children.length() / 2);
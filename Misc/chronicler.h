@@ -19,10 +19,12 @@ QT_END_NAMESPACE
 class CMainWindow;
 class CGraphicsScene;
 class CGraphicsView;
+class CMinimap;
 class CHomepage;
 class CSettingsView;
 class CProjectView;
 class CVariablesView;
+class CSymbolTable;
 class CDockManager;
 class CPaletteButton;
 class CPaletteAction;
@@ -38,7 +40,7 @@ namespace Chronicler
 
     enum Mode { InsertConnection, Cursor, InsertStory, InsertCondition, InsertChoice, InsertAction, InsertCode, InsertStartHere, Paint };
 
-    enum Command { AddBubblesCommand, RemoveBubblesCommand, MoveBubblesCommand, ResizeBubbleCommand, RemoveSceneCommand };
+    enum Command { AddBubblesCommand, RemoveBubblesCommand, MoveBubblesCommand, ResizeBubbleCommand, RemoveSceneCommand, EditBubbleCommand };
 
     enum Stat { TextStat, PercentStat, OpposedPairStat, CustomStat };
 
@@ -122,7 +124,7 @@ namespace Chronicler
     /// @brief Do NOT instantiate this struct, use shared() singleton access.
     struct SharedInstances
     {
-        const CVersion ProgramVersion = CVersion("0.11.1.0");
+        const CVersion ProgramVersion = CVersion("0.11.2.0");
 
         CMainWindow *mainWindow;
 
@@ -132,10 +134,14 @@ namespace Chronicler
         CSettingsView *settingsView;
         CProjectView *projectView;
         CVariablesView *variablesView;
+        CSymbolTable *symbolTable;
 
         QDockWidget *dock;
         CDockManager *dockManager;
 
+        QDockWidget *minimapDock;
+        CMinimap *minimap;
+
         QStatusBar *statusBar;
 
         QToolBar *pointerToolBar;
@@ -165,6 +171,7 @@ namespace Chronicler
         QAction *saveAsProjectAction;
         QAction *showHomepageAction;
         QAction *showDockAction;
+        QAction *showMinimapAction;
         QAction *undoAction;
         QAction *redoAction;
         QAction *quickTestAction;
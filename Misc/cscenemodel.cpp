@@ -45,7 +45,13 @@ Qt::ItemFlags CSceneModel::flags(const QModelIndex &index) const
 void CSceneModel::setViews(const QList<CGraphicsView *> &views)
 {
     beginResetModel();
+    for(CGraphicsView *view : m_views)
+        Unregister(view->cScene());
+
     m_views = views;
+
+    for(CGraphicsView *view : m_views)
+        Register(view->cScene());
     endResetModel();
 }
 
@@ -56,37 +62,64 @@ QList<CGraphicsView *> CSceneModel::views()
 
 CGraphicsScene *CSceneModel::sceneWithName(const QString &name)
 {
-    for(CGraphicsView *view : m_views)
-        if(view->cScene()->name() == name)
-            return view->cScene();
-
-    return Q_NULLPTR;
+    return m_scenes.value(name, Q_NULLPTR);
 }
 
 QString CSceneModel::uniqueName(const QString &scene, int row)
 {
-    int val = 1;
-    QString name = scene;
-    name.replace(" ", "_");
-    bool found = true;
+    QString base = scene;
+    base.replace(" ", "_");
 
-    while(found)
+    // the scene being renamed may keep its own name
+    CGraphicsScene *self = (row >= 0 && row < m_views.length()) ? m_views[row]->cScene() : Q_NULLPTR;
+
+    QString name = base;
+    CGraphicsScene *owner = m_scenes.value(name, Q_NULLPTR);
+    if(!owner || owner == self)
+        return name;
+
+    // continue after the last suffix given to this base name instead of counting up from 2 again
+    int &val = m_suffixes[base];
+    if(val < 1)
+        val = 1;
+
+    do
     {
-        found = false;
-        for(int i = 0; i < m_views.length(); ++i)
-        {
-            if(i != row && m_views[i]->cScene()->name() == name)
-            {
-                name = scene + "_" + QString::number(++val);
-                found = true;
-                break;
-            }
-        }
+        name = base + "_" + QString::number(++val);
+        owner = m_scenes.value(name, Q_NULLPTR);
     }
+    while(owner && owner != self);
 
     return name;
 }
 
+void CSceneModel::Register(CGraphicsScene *scene)
+{
+    m_scenes.insert(scene->name(), scene);
+    m_sceneNames.insert(scene, scene->name());
+
+    connect(scene, SIGNAL(nameChanged()), this, SLOT(SceneRenamed()), Qt::UniqueConnection);
+}
+
+void CSceneModel::Unregister(CGraphicsScene *scene)
+{
+    disconnect(scene, SIGNAL(nameChanged()), this, SLOT(SceneRenamed()));
+
+    const QString name = m_sceneNames.take(scene);
+    if(m_scenes.value(name) == scene)
+        m_scenes.remove(name);
+}
+
+void CSceneModel::SceneRenamed()
+{
+    CGraphicsScene *scene = qobject_cast<CGraphicsScene *>(sender());
+    if(!scene || !m_sceneNames.contains(scene))
+        return;
+
+    Unregister(scene);
+    Register(scene);
+}
+
 void CSceneModel::MoveUp(const int index)
 {
     if(index > 1 && index < m_views.length())
@@ -110,6 +143,7 @@ void CSceneModel::AddItem(CGraphicsView *view)
     beginInsertRows(QModelIndex(), index, index);
     view->cScene()->setName(uniqueName(view->cScene()->name(), -1));
     m_views.append(view);
+    Register(view->cScene());
     endInsertRows();
 }
 
@@ -118,12 +152,14 @@ void CSceneModel::InsertItem(CGraphicsView *view, int index)
     beginInsertRows(QModelIndex(), index, index);
     view->cScene()->setName(uniqueName(view->cScene()->name(), -1));
     m_views.insert(index, view);
+    Register(view->cScene());
     endInsertRows();
 }
 
 void CSceneModel::RemoveItem(const int index)
 {
     beginRemoveRows(QModelIndex(), index, index);
+    Unregister(m_views[index]->cScene());
     delete m_views[index];
     m_views.removeAt(index);
     endRemoveRows();
@@ -134,6 +170,7 @@ void CSceneModel::ExtractItem(CGraphicsView *view)
     const int index = m_views.indexOf(view);
 
     beginRemoveRows(QModelIndex(), index, index);
+    Unregister(view->cScene());
     m_views.removeAt(index);
     endRemoveRows();
 }
@@ -143,5 +180,6 @@ void CSceneModel::Reset()
     beginResetModel();
     while(m_views.length())
         RemoveItem(0);
+    m_suffixes.clear();
     endResetModel();
 }
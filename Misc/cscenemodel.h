@@ -2,12 +2,15 @@
 #define CSCENEMODEL_H
 
 #include <QAbstractListModel>
+#include <QHash>
 
 class CGraphicsView;
 class CGraphicsScene;
 
 class CSceneModel : public QAbstractListModel
 {
+    Q_OBJECT
+
 public:
     explicit CSceneModel(QObject *parent = Q_NULLPTR);
 
@@ -35,8 +38,20 @@ public:
     void Reset();
 
 private:
+    void Register(CGraphicsScene *scene);
+    void Unregister(CGraphicsScene *scene);
+
     QList<CGraphicsView *> m_views;
 
+    // name lookups, kept in sync through the nameChanged() signal of every scene
+    QHash<QString, CGraphicsScene *> m_scenes;
+    QHash<CGraphicsScene *, QString> m_sceneNames;
+
+    // last suffix handed out for each base name
+    QHash<QString, int> m_suffixes;
+
+private slots:
+    void SceneRenamed();
 };
 
 #endif // CSCENEMODEL_H
@@ -5,6 +5,8 @@
 #include "Misc/chronicler.h"
 using Chronicler::shared;
 
+const CVersion *CSerializable::m_version = Q_NULLPTR;
+
 QDataStream &operator <<(QDataStream &stream, const CSerializable &serializable)
 {
     return serializable.Serialize(stream);
@@ -12,7 +14,8 @@ QDataStream &operator <<(QDataStream &stream, const CSerializable &serializable)
 
 QDataStream &operator >>(QDataStream &stream, CSerializable &serializable)
 {
-    return serializable.Deserialize(stream, shared().projectView->getVersion());
+    return serializable.Deserialize(stream, CSerializable::m_version ? *CSerializable::m_version
+                                                                     : shared().projectView->getVersion());
 }
 
 CSerializable::~CSerializable()
@@ -20,3 +23,15 @@ CSerializable::~CSerializable()
 
 CSerializable::CSerializable()
 {}
+
+
+CSerializable::VersionOverride::VersionOverride(const CVersion &version)
+    : m_previous(CSerializable::m_version)
+{
+    CSerializable::m_version = &version;
+}
+
+CSerializable::VersionOverride::~VersionOverride()
+{
+    CSerializable::m_version = m_previous;
+}
@@ -14,11 +14,28 @@ public:
 
     virtual ~CSerializable();
 
+    /**
+     * @brief While alive, operator >> reads data written in version instead of
+     *        the version of the open project. For data written during this session.
+     */
+    class VersionOverride
+    {
+    public:
+        explicit VersionOverride(const CVersion &version);
+        ~VersionOverride();
+
+    private:
+        const CVersion *m_previous;
+    };
+
 protected:
     CSerializable();
 
     virtual QDataStream &Deserialize(QDataStream &ds, const CVersion &version) = 0;
     virtual QDataStream &Serialize(QDataStream &ds) const = 0;
+
+private:
+    static const CVersion *m_version;
 };
 
 #endif // CSERIALIZABLE_H
@@ -1,10 +1,10 @@
 #include "cshighlighter.h"
 
-#include <QRegularExpressionMatchIterator>
+#include <QSet>
 
+#include "Misc/cslexer.h"
 #include "Properties/cvariablesview.h"
 #include "Misc/Variables/cvariablesmodel.h"
-#include "Misc/Variables/cvariable.h"
 #include "Misc/chronicler.h"
 using Chronicler::shared;
 
@@ -12,80 +12,57 @@ using Chronicler::shared;
 CSHighlighter::CSHighlighter(QTextDocument *parent)
     : QSyntaxHighlighter(parent)
 {
-    HighlightingRule rule;
-
     m_variableFormat.setFontItalic(true);
     m_variableFormat.setForeground(Qt::darkCyan);
 
     m_actionFormat.setFontWeight(QFont::Bold);
     m_actionFormat.setForeground(Qt::darkMagenta);
-    rule.pattern = QRegularExpression("\\*(if|elseif)[^\n]*(and|or)|\\*\\w+|%\\+|%-|\\+|-|=|\\*|/|\\<|\\>|");
-    rule.format = m_actionFormat;
-    m_highlightingRules.append(rule);
 
     m_numberFormat.setForeground(Qt::darkBlue);
-    rule.pattern = QRegularExpression("\\d+");
-    rule.format = m_numberFormat;
-    m_highlightingRules.append(rule);
 
     m_commentFormat.setForeground(Qt::darkGreen);
-    rule.pattern = QRegularExpression("\\*comment[^\n]*");
-    rule.format = m_commentFormat;
-    m_highlightingRules.append(rule);
 
     m_quotationFormat.setForeground(Qt::darkRed);
-    rule.pattern = QRegularExpression("\".*\"");
-    rule.format = m_quotationFormat;
-    m_highlightingRules.append(rule);
 }
 
 
 void CSHighlighter::highlightBlock(const QString &text)
 {
-    // everything but variables
-    foreach (const HighlightingRule &rule, m_highlightingRules)
-    {
-        QRegularExpressionMatchIterator i = rule.pattern.globalMatch(text);
-        while(i.hasNext())
-        {
-            QRegularExpressionMatch match = i.next();
-            setFormat(match.capturedStart(), match.capturedLength(), rule.format);
-        }
-    }
-
-    // variables
-    QRegularExpression action("(\\*\\w+)");
-    QRegularExpression dispVar("\\${([[:alpha:]_]\\w*)}");
-    QRegularExpression white_space("\\s|\\n");
+    static const QSet<QString> noNames;
+    const QSet<QString> &names = shared().variablesView ? shared().variablesView->model()->names() : noNames;
 
-    if(action.match(text).hasMatch())
-    {
-        for(const CVariable v : shared().variablesView->model()->variables())
-        {
-            int start = 0;
-            int end = text.indexOf(white_space);
-            int diff = end;
-            QString token = text.left(end);
-
-            while(end != -1)
-            {
-                if(!action.match(token).hasMatch() && token.contains(v.name()))
-                    setFormat(start, diff, m_variableFormat);
+    // quotes may continue from the previous block
+    int state = (previousBlockState() == CSLexer::InString) ? CSLexer::InString : CSLexer::Normal;
 
-                start = end + 1;
-                end = text.indexOf(white_space, start);
-                diff = end - start;
-                token = text.mid(start, diff);
-            }
-        }
-    }
-    else
+    for(const CSLexer::Token &token : CSLexer::Tokenize(text, state))
     {
-        QRegularExpressionMatchIterator i = dispVar.globalMatch(text);
-        while(i.hasNext())
+        switch(token.type)
         {
-            QRegularExpressionMatch match = i.next();
-            setFormat(match.capturedStart(), match.capturedLength(), m_variableFormat);
+        case CSLexer::Command:
+        case CSLexer::Keyword:
+        case CSLexer::Operator:
+            setFormat(token.start, token.length, m_actionFormat);
+            break;
+        case CSLexer::Comment:
+            setFormat(token.start, token.length, m_commentFormat);
+            break;
+        case CSLexer::Number:
+            setFormat(token.start, token.length, m_numberFormat);
+            break;
+        case CSLexer::String:
+            setFormat(token.start, token.length, m_quotationFormat);
+            break;
+        case CSLexer::Variable:
+            setFormat(token.start, token.length, m_variableFormat);
+            break;
+        case CSLexer::Identifier:
+            if(names.contains(text.mid(token.start, token.length)))
+                setFormat(token.start, token.length, m_variableFormat);
+            break;
+        case CSLexer::Label:
+            break;
         }
     }
+
+    setCurrentBlockState(state);
 }
@@ -2,7 +2,6 @@
 #define CSHIGHLIGHTER_H
 
 #include <QSyntaxHighlighter>
-#include <QRegularExpression>
 
 class CSHighlighter : public QSyntaxHighlighter
 {
@@ -12,13 +11,6 @@ public:
 protected:
     virtual void highlightBlock(const QString &text) Q_DECL_OVERRIDE;
 
-    struct HighlightingRule
-    {
-        QRegularExpression pattern;
-        QTextCharFormat format;
-    };
-    QVector<HighlightingRule> m_highlightingRules;
-
     QTextCharFormat m_actionFormat;
     QTextCharFormat m_variableFormat;
     QTextCharFormat m_numberFormat;
@@ -0,0 +1,266 @@
+#include "cslexer.h"
+
+#include <QSet>
+#include <QStringList>
+
+
+static const QString operators("+-*/%=<>&");
+
+static inline bool isWordChar(const QChar &c)
+{
+    return c.isLetterOrNumber() || c == '_';
+}
+
+static inline CSLexer::Token token(CSLexer::TokenType type, int start, int length)
+{
+    CSLexer::Token t = { type, start, length };
+    return t;
+}
+
+// commands followed by labels (and scenes) instead of expressions
+static int labelCount(const QString &command)
+{
+    if(command == "label" || command == "goto" || command == "gosub")
+        return 1;
+    else if(command == "goto_scene" || command == "gosub_scene")
+        return 2;
+
+    return 0;
+}
+
+// commands followed by plain text
+static bool isTextCommand(const QString &command)
+{
+    static const QSet<QString> commands = QSet<QString>() << "page_break" << "finish" << "title"
+        << "author" << "image" << "text_image" << "sound" << "link" << "bug" << "achievement"
+        << "achieve" << "ending" << "restart" << "line_break" << "choice" << "fake_choice";
+    return commands.contains(command);
+}
+
+static bool isKeyword(const QString &word)
+{
+    static const QSet<QString> keywords = QSet<QString>() << "and" << "or" << "not" << "true"
+        << "false" << "modulo" << "round" << "length";
+    return keywords.contains(word);
+}
+
+/**
+ * @brief Length of the interpolation starting at pos, ${name}, $!{name} or $!!{name}.
+ * Returns 0 if there is none.
+ */
+static int interpolationLength(const QString &line, int pos)
+{
+    const int length = line.length();
+
+    int i = pos + 1;
+    while(i < length && i - pos < 3 && line.at(i) == '!')
+        ++i;
+    if(i >= length || line.at(i) != '{')
+        return 0;
+
+    const int nameStart = ++i;
+    while(i < length && isWordChar(line.at(i)))
+        ++i;
+
+    if(i == nameStart || i >= length || line.at(i) != '}' || line.at(nameStart).isDigit())
+        return 0;
+
+    return i + 1 - pos;
+}
+
+static int lexProse(const QString &line, int i, QVector<CSLexer::Token> &tokens, bool inString)
+{
+    QVector<CSLexer::Token> variables;
+
+    const int length = line.length();
+    int stringStart = 0;
+    while(i < length)
+    {
+        const QChar c = line.at(i);
+        int n;
+
+        if(c == '"')
+        {
+            if(inString)
+                tokens.append(token(CSLexer::String, stringStart, i + 1 - stringStart));
+            else
+                stringStart = i;
+
+            inString = !inString;
+            ++i;
+        }
+        else if(c == '$' && (n = interpolationLength(line, i)))
+        {
+            variables.append(token(CSLexer::Variable, i, n));
+            i += n;
+        }
+        else if(isWordChar(c))
+        {
+            const int start = i;
+            while(i < length && isWordChar(line.at(i)))
+                ++i;
+
+            // digits inside of words aren't numbers
+            bool number = !inString;
+            for(int j = start; j < i && number; ++j)
+                number = line.at(j).isDigit();
+            if(number)
+                tokens.append(token(CSLexer::Number, start, i - start));
+        }
+        else
+            ++i;
+    }
+
+    if(inString)
+        tokens.append(token(CSLexer::String, stringStart, length - stringStart));
+
+    // interpolations go last so they are drawn on top of the strings they are in
+    tokens += variables;
+
+    return inString ? CSLexer::InString : CSLexer::Normal;
+}
+
+static void lexExpression(const QString &line, int i, QVector<CSLexer::Token> &tokens, int labels)
+{
+    QVector<CSLexer::Token> variables;
+
+    const int length = line.length();
+    while(i < length)
+    {
+        const QChar c = line.at(i);
+        const QChar next = (i + 1 < length) ? line.at(i + 1) : QChar();
+
+        if(c.isSpace())
+            ++i;
+        else if(c == '"')
+        {
+            // strings in expressions always end with the line
+            const int start = i++;
+            while(i < length && line.at(i) != '"')
+            {
+                int n;
+                if(line.at(i) == '\\')
+                    i += 2;
+                else if(line.at(i) == '$' && (n = interpolationLength(line, i)))
+                {
+                    variables.append(token(CSLexer::Variable, i, n));
+                    i += n;
+                }
+                else
+                    ++i;
+            }
+            i = qMin(i + 1, length);
+            tokens.append(token(CSLexer::String, start, i - start));
+        }
+        else if(c.isDigit())
+        {
+            const int start = i;
+            while(i < length && (line.at(i).isDigit() || line.at(i) == '.'))
+                ++i;
+            tokens.append(token(CSLexer::Number, start, i - start));
+        }
+        else if(isWordChar(c))
+        {
+            const int start = i;
+            while(i < length && isWordChar(line.at(i)))
+                ++i;
+
+            if(labels > 0)
+            {
+                tokens.append(token(CSLexer::Label, start, i - start));
+                --labels;
+            }
+            else
+            {
+                const bool keyword = isKeyword(line.mid(start, i - start).toLower());
+                tokens.append(token(keyword ? CSLexer::Keyword : CSLexer::Identifier, start, i - start));
+            }
+        }
+        else if(c == '*' && next.isLetter() && line.at(i - 1).isSpace())
+        {
+            // *if (...) #Option and friends, hand the rest back to the line lexer
+            int state = CSLexer::Normal;
+            QVector<CSLexer::Token> rest = CSLexer::Tokenize(line.mid(i), state);
+            for(CSLexer::Token &t : rest)
+                t.start += i;
+            tokens += rest;
+            break;
+        }
+        else if(c == '#')
+        {
+            lexProse(line, i + 1, tokens, false);
+            break;
+        }
+        else if((c == '%' && (next == '+' || next == '-')) || ((c == '<' || c == '>' || c == '!') && next == '='))
+        {
+            tokens.append(token(CSLexer::Operator, i, 2));
+            i += 2;
+        }
+        else if(operators.contains(c))
+        {
+            tokens.append(token(CSLexer::Operator, i, 1));
+            ++i;
+        }
+        else
+            ++i;
+    }
+
+    tokens += variables;
+}
+
+
+/**
+ * @brief Splits a line into tokens, state is the state the previous line ended in
+ * and is updated to the state this line ends in.
+ * Tokens are in order, except for interpolations which follow the strings containing them.
+ */
+QVector<CSLexer::Token> CSLexer::Tokenize(const QString &line, int &state)
+{
+    QVector<Token> tokens;
+
+    const int length = line.length();
+    int i = 0;
+    while(i < length && line.at(i).isSpace())
+        ++i;
+
+    // commands never live inside of quotes, an unbalanced quote ends here
+    if(i < length && line.at(i) == '*')
+    {
+        const int start = i++;
+        while(i < length && isWordChar(line.at(i)))
+            ++i;
+
+        const QString command = line.mid(start + 1, i - start - 1);
+        if(command == "comment")
+            tokens.append(token(Comment, start, length - start));
+        else
+        {
+            tokens.append(token(Command, start, i - start));
+
+            if(isTextCommand(command))
+                lexProse(line, i, tokens, false);
+            else
+                lexExpression(line, i, tokens, labelCount(command));
+        }
+
+        state = Normal;
+    }
+    else
+        state = lexProse(line, i, tokens, state == InString);
+
+    return tokens;
+}
+
+/**
+ * @brief Name of the variable referenced by an Identifier or Variable token.
+ */
+QString CSLexer::VariableName(const QString &line, const Token &token)
+{
+    if(token.type == Variable)
+    {
+        const int open = line.indexOf('{', token.start);
+        return line.mid(open + 1, token.start + token.length - open - 2);
+    }
+
+    return line.mid(token.start, token.length);
+}
@@ -0,0 +1,31 @@
+#ifndef CSLEXER_H
+#define CSLEXER_H
+
+#include <QString>
+#include <QVector>
+
+
+/**
+ * @brief Single pass lexer for ChoiceScript, one line at a time.
+ * Lines starting with a command are lexed as expressions, anything else is prose
+ * where only quotes, numbers and ${} interpolations are picked up.
+ * Quotes in prose may span several lines, the state carries that over to the next line.
+ */
+class CSLexer
+{
+public:
+    enum TokenType { Command, Comment, Keyword, Operator, Number, String, Identifier, Variable, Label };
+    enum State { Normal = 0, InString = 1 };
+
+    struct Token
+    {
+        TokenType type;
+        int start;
+        int length;
+    };
+
+    static QVector<Token> Tokenize(const QString &line, int &state);
+    static QString VariableName(const QString &line, const Token &token);
+};
+
+#endif // CSLEXER_H
@@ -0,0 +1,63 @@
+#include "cspellchecker.h"
+
+#include <QThread>
+#include <QCoreApplication>
+
+#include "Misc/cdictionary.h"
+
+
+CSpellChecker::CSpellChecker(const QSharedPointer<CDictionary> &dictionary)
+    : QObject(), m_dictionary(dictionary)
+{
+    moveToThread(workerThread());
+}
+
+/**
+ * @brief Low priority thread shared by all spell checkers, stopped when the application quits.
+ */
+QThread *CSpellChecker::workerThread()
+{
+    static QThread *thread = Q_NULLPTR;
+
+    if(!thread)
+    {
+        thread = new QThread(QCoreApplication::instance());
+        thread->setObjectName("SpellChecker");
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, []() {
+            thread->quit();
+            thread->wait();
+        });
+        thread->start(QThread::LowPriority);
+    }
+
+    return thread;
+}
+
+void CSpellChecker::CheckBlock(int block, const QString &text)
+{
+    if(m_dictionary)
+    {
+        for(const CDictionary::Word &word : CDictionary::Words(text))
+            m_dictionary->spell(text.mid(word.first, word.second));
+    }
+
+    emit BlockChecked(block, text);
+}
+
+/**
+ * @brief Checks the word and looks up suggestions only if it is misspelled,
+ *        for a menu that opened before the word was known.
+ */
+void CSpellChecker::Suggest(const QString &word)
+{
+    bool correct = true;
+    QStringList suggestions;
+    if(m_dictionary)
+    {
+        correct = m_dictionary->spell(word);
+        if(!correct)
+            suggestions = m_dictionary->suggest(word);
+    }
+
+    emit Suggested(word, correct, suggestions);
+}
@@ -0,0 +1,40 @@
+#ifndef CSPELLCHECKER_H
+#define CSPELLCHECKER_H
+
+#include <QObject>
+#include <QSharedPointer>
+
+QT_BEGIN_NAMESPACE
+class QThread;
+QT_END_NAMESPACE
+
+class CDictionary;
+
+
+/**
+ * @brief Runs Hunspell lookups on a background thread.
+ * Results end up in the dictionary's cache, the owner is told when a
+ * block is done so it can re-apply its formats without blocking.
+ */
+class CSpellChecker : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit CSpellChecker(const QSharedPointer<CDictionary> &dictionary);
+
+    static QThread *workerThread();
+
+public slots:
+    void CheckBlock(int block, const QString &text);
+    void Suggest(const QString &word);
+
+signals:
+    void BlockChecked(int block, const QString &text);
+    void Suggested(const QString &word, bool correct, const QStringList &suggestions);
+
+private:
+    QSharedPointer<CDictionary> m_dictionary;
+};
+
+#endif // CSPELLCHECKER_H
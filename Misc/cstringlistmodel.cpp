@@ -1,12 +1,73 @@
 #include "cstringlistmodel.h"
 
 CStringListModel::CStringListModel(QObject *parent)
-    : QStringListModel(parent)
+    : QAbstractListModel(parent), m_nextId(1)
 {}
 
 CStringListModel::CStringListModel(const QStringList &strings, QObject *parent)
-    : QStringListModel(strings, parent)
-{}
+    : QAbstractListModel(parent), m_strings(strings), m_nextId(1)
+{
+    InsertIds(0, m_strings.length());
+}
+
+int CStringListModel::rowCount(const QModelIndex &parent) const
+{
+    if(parent.isValid())
+        return 0;
+
+    return m_strings.length();
+}
+
+QVariant CStringListModel::data(const QModelIndex &index, int role) const
+{
+    if(!index.isValid() || index.row() >= m_strings.length())
+        return QVariant();
+
+    if(role == Qt::DisplayRole || role == Qt::EditRole)
+        return m_strings.at(index.row());
+
+    return QVariant();
+}
+
+bool CStringListModel::setData(const QModelIndex &index, const QVariant &value, int role)
+{
+    if(index.isValid() && index.row() < m_strings.length() && (role == Qt::EditRole || role == Qt::DisplayRole))
+    {
+        m_strings[index.row()] = value.toString();
+
+        emit dataChanged(index, index, {Qt::DisplayRole, Qt::EditRole});
+        return true;
+    }
+
+    return false;
+}
+
+bool CStringListModel::insertRows(int row, int count, const QModelIndex &parent)
+{
+    if(count < 1 || row < 0 || row > rowCount(parent) || parent.isValid())
+        return false;
+
+    beginInsertRows(QModelIndex(), row, row + count - 1);
+    for(int i = 0; i < count; ++i)
+        m_strings.insert(row, QString());
+    InsertIds(row, count);
+    endInsertRows();
+
+    return true;
+}
+
+bool CStringListModel::removeRows(int row, int count, const QModelIndex &parent)
+{
+    if(count < 1 || row < 0 || row + count > rowCount(parent) || parent.isValid())
+        return false;
+
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    m_strings.erase(m_strings.begin() + row, m_strings.begin() + row + count);
+    m_ids.erase(m_ids.begin() + row, m_ids.begin() + row + count);
+    endRemoveRows();
+
+    return true;
+}
 
 Qt::ItemFlags CStringListModel::flags(const QModelIndex &index) const
 {
@@ -15,33 +76,58 @@ Qt::ItemFlags CStringListModel::flags(const QModelIndex &index) const
     return flags | (index.isValid() ? Qt::ItemIsDragEnabled : Qt::ItemIsDropEnabled);
 }
 
+Qt::DropActions CStringListModel::supportedDropActions() const
+{
+    return Qt::CopyAction | Qt::MoveAction;
+}
+
+void CStringListModel::setStringList(const QStringList &strings)
+{
+    beginResetModel();
+    m_strings = strings;
+    m_ids.clear();
+    InsertIds(0, m_strings.length());
+    endResetModel();
+}
+
+void CStringListModel::InsertIds(int row, int count)
+{
+    for(int i = 0; i < count; ++i)
+        m_ids.insert(row + i, m_nextId++);
+}
+
+
+// the models below are edited in place, resetting them would rebuild every attached view
 
 void CStringListModel::MoveUp(const int index)
 {
-    if(index > 0 && index < stringList().length())
+    if(index > 0 && index < m_strings.length())
     {
-        QStringList lst = stringList();
-        lst.swap(index, index - 1);
-        setStringList(lst);
+        beginMoveRows(QModelIndex(), index, index, QModelIndex(), index - 1);
+        m_strings.swap(index, index - 1);
+        m_ids.swap(index, index - 1);
+        endMoveRows();
     }
 }
 
 void CStringListModel::MoveDown(const int index)
 {
-    if(index >= 0 && index < stringList().length() - 1)
+    if(index >= 0 && index < rowCount() - 1)
         MoveUp(index + 1);
 }
 
+// the row is published with its text, never blank first
 void CStringListModel::AddItem(const QString &action)
 {
-    QStringList lst = stringList();
-    lst.append(action);
-    setStringList(lst);
+    const int row = m_strings.length();
+    beginInsertRows(QModelIndex(), row, row);
+    m_strings.append(action);
+    InsertIds(row, 1);
+    endInsertRows();
 }
 
 void CStringListModel::RemoveItem(const int index)
 {
-    QStringList lst = stringList();
-    lst.removeAt(index);
-    setStringList(lst);
+    if(index >= 0 && index < rowCount())
+        removeRows(index, 1);
 }
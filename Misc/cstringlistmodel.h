@@ -2,20 +2,47 @@
 #define CSTRINGLISTMODEL_H
 
 
-#include <QStringListModel>
+#include <QAbstractListModel>
+#include <QStringList>
 
-class CStringListModel : public virtual QStringListModel
+/**
+ * @brief Editable list of strings, rows are inserted with their text and moved in place.
+ * Every row gets an id that stays with it while rows around it are inserted, moved or removed.
+ */
+class CStringListModel : public QAbstractListModel
 {
 public:
     CStringListModel(QObject *parent = 0);
     CStringListModel(const QStringList &strings, QObject *parent = 0);
 
-    virtual Qt::ItemFlags flags(const QModelIndex &index) const;
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+
+    virtual QVariant data(const QModelIndex &index, int role) const override;
+    virtual bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) override;
+
+    virtual bool insertRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
+    virtual bool removeRows(int row, int count, const QModelIndex &parent = QModelIndex()) override;
+
+    virtual Qt::ItemFlags flags(const QModelIndex &index) const override;
+    virtual Qt::DropActions supportedDropActions() const override;
+
+    QStringList stringList() const { return m_strings; }
+    void setStringList(const QStringList &strings);
+
+    quint64 rowId(int row) const { return m_ids.value(row); }
+    int rowWithId(quint64 id) const { return m_ids.indexOf(id); }
 
     void MoveUp(const int index);
     void MoveDown(const int index);
     void AddItem(const QString &action);
     void RemoveItem(const int index);
+
+private:
+    void InsertIds(int row, int count);
+
+    QStringList m_strings;
+    QList<quint64> m_ids;
+    quint64 m_nextId;
 };
 
 #endif // CSTRINGLISTMODEL_H
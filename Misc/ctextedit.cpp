@@ -1,6 +1,8 @@
 #include "ctextedit.h"
 
 #include "Misc/cshighlighter.h"
+#include "Misc/cdictionary.h"
+#include "Misc/ccompletionmodel.h"
 
 #include "Misc/chronicler.h"
 using Chronicler::shared;
@@ -13,13 +15,14 @@ CTextEdit::CTextEdit(QWidget * parent, QStringListModel * model, const QString &
     if(!m_completionModel)
         m_completionModel = new QStringListModel(this);
 
-    m_filtered = new QStringListModel(this);
+    m_filtered = new CCompletionModel(this);
+    m_filtered->setSource(m_completionModel);
 
     setCompleter(new QCompleter(m_filtered, this));
 
     connect(shared().escapeAction, SIGNAL(triggered(bool)), this, SLOT(EscapePressed()));
 
-    QString dictPath = QCoreApplication::applicationDirPath() + "/en_US.dic";
+    QString dictPath = CDictionary::defaultPath();
     setDict(dictPath);
 
     Highlighter *highlighter = new Highlighter(document(), dictPath, true);
@@ -41,7 +44,8 @@ void CTextEdit::setCompleter(QCompleter *completer)
         m_completer->setWidget(this);
         m_completer->setCompletionMode(QCompleter::PopupCompletion);
         m_completer->setCaseSensitivity(Qt::CaseInsensitive);
-        m_completer->setModelSorting(QCompleter::CaseInsensitivelySortedModel);
+        // ranked by use, not alphabetically
+        m_completer->setModelSorting(QCompleter::UnsortedModel);
         m_completer->setModel(m_filtered);
 
         QObject::connect(m_completer, SIGNAL(activated(QString)),
@@ -98,6 +102,22 @@ void CTextEdit::setAlwaysEnabled(bool alwaysEnabled)
         m_completer->popup();
 }
 
+/**
+ * @brief Replaces the text if it differs, keeping the cursor where it was.
+ */
+void CTextEdit::Refresh(const QString &text)
+{
+    if(toPlainText() == text)
+        return;
+
+    const int position = textCursor().position();
+    setPlainText(text);
+
+    QTextCursor cursor = textCursor();
+    cursor.setPosition(qMin(position, text.length()));
+    setTextCursor(cursor);
+}
+
 QStringListModel *CTextEdit::model() const
 {
     return m_completionModel;
@@ -106,6 +126,7 @@ QStringListModel *CTextEdit::model() const
 void CTextEdit::setModel(QStringListModel *model)
 {
     m_completionModel = model;
+    m_filtered->setSource(model);
 }
 
 
@@ -171,6 +192,8 @@ void CTextEdit::insertCompletion(const QString& completion)
     tc.insertText(completion);
 
     setTextCursor(tc);
+
+    CCompletionIndex::Used(completion);
 }
 
 void CTextEdit::EscapePressed()
@@ -229,16 +252,12 @@ void CTextEdit::keyPressEvent(QKeyEvent *e)
     if (!m_completer || ctrlMod || (shiftMod && e->text().isEmpty()))
         return;
 
-    QString completionPrefix = textUnderCursor().replace("*","\\*");
-    completionPrefix = completionPrefix.replace("$", "\\$");
-    completionPrefix = completionPrefix.replace("{", "\\{");
-
-    QStringList filteredList = m_completionModel->stringList().filter(QRegExp("*"+completionPrefix+"*", m_completer->caseSensitivity(), QRegExp::WildcardUnix));
-    m_filtered->setStringList(filteredList);
+    const QString completionPrefix = textUnderCursor();
+    m_filtered->setPrefix(completionPrefix);
 
 
     if (!m_alwaysEnabled && ((!m_enabled) || (shiftMod || e->text().isEmpty() || (completionPrefix.isEmpty() && !isEscape) ||
-                                              (!filteredList.isEmpty() && completionPrefix == filteredList.first()))))
+                                              (m_filtered->rowCount() > 0 && completionPrefix == m_filtered->completion(0)))))
     {
         m_completer->popup()->hide();
     }
@@ -17,6 +17,8 @@
 #include <QFile>
 #include <QByteArray>
 
+class CCompletionModel;
+
 
 
 
@@ -35,6 +37,8 @@ public:
 
     void setAlwaysEnabled(bool alwaysEnabled);
 
+    void Refresh(const QString &text);
+
     bool acceptsTab() const;
     void setAcceptsTab(bool acceptsTab);
 
@@ -49,7 +53,7 @@ private:
 protected:
     QCompleter * m_completer;
     QStringListModel * m_completionModel;
-    QStringListModel * m_filtered;
+    CCompletionModel * m_filtered;
     bool m_enabled;
     bool m_alwaysEnabled;
 
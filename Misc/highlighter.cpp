@@ -42,76 +42,50 @@
  ****************************************************************************/
 
 #include <QtGui>
-#include <iostream>
 #include "highlighter.h"
+#include "Misc/cdictionary.h"
+#include "Misc/cspellchecker.h"
 
 Highlighter::Highlighter(QTextDocument *parent,QString SpellDic,bool spellCheckState)
-    : CSHighlighter(parent)
+    : CSHighlighter(parent), checker(0)
 {
-    HighlightingRule rule;
-
     spellCheckFormat.setUnderlineColor(QColor(Qt::red));
     spellCheckFormat.setUnderlineStyle(QTextCharFormat::SpellCheckUnderline);
 
     //Settings for online spellchecking
     if(SpellDic!=""){
-        //mWords.clear();
-        spell_dic=SpellDic.left(SpellDic.length()-4);
-        pChecker = new Hunspell(spell_dic.toLatin1()+".aff",spell_dic.toLatin1()+".dic");
-        spell_encoding=QString(pChecker->get_dic_encoding());
-        codec = QTextCodec::codecForName(spell_encoding.toLatin1());
-
-        QFileInfo fi(SpellDic);
-        if (fi.exists() && fi.isReadable()) spellCheckActive=true;
-        else spellCheckActive=false;
-        // get user config dictionary
-        QSettings setting;
-        QString filePath=QFileInfo(setting.fileName()).absoluteFilePath();
-        filePath=filePath+"/User_"+QFileInfo(spell_dic.toLatin1()+".dic").fileName();
-        std::cout << qPrintable(filePath) << std::endl;
-        fi=QFileInfo(filePath);
-        if (fi.exists() && fi.isReadable()){
-            pChecker->add_dic(filePath.toLatin1());
-        }
-        else filePath="";
+        // shared with every other editor, loaded only once
+        dictionary = CDictionary::Acquire(SpellDic);
+        spellCheckActive = dictionary->isValid();
     }
     else spellCheckActive=false;
     spellerError=!spellCheckActive;
     spellCheckActive=spellCheckActive && spellCheckState;
+
+    createChecker();
 }
 
 Highlighter::~Highlighter() {
-    delete pChecker;
+    // lives on the worker thread
+    if (checker)
+        checker->deleteLater();
+}
+
+void Highlighter::createChecker()
+{
+    if (checker)
+        checker->deleteLater();
+
+    checker = new CSpellChecker(dictionary);
+    connect(this, SIGNAL(checkBlock(int,QString)), checker, SLOT(CheckBlock(int,QString)));
+    connect(checker, SIGNAL(BlockChecked(int,QString)), this, SLOT(slot_blockChecked(int,QString)));
+    pendingBlocks.clear();
 }
 
 
 void Highlighter::highlightBlock(const QString &text)
 {
-    // split text into words
-    QString str = text.simplified();
-    if (!str.isEmpty()) {
-        QStringList Checkliste = str.split(QRegExp("([^\\w,^\\\\]|(?=\\\\))+"),
-                                           QString::SkipEmptyParts);
-        int l,number;
-        // check all words
-        for (int i=0; i<Checkliste.size(); ++i) {
-            str = Checkliste.at(i);
-            if (str.length()>1 &&!str.startsWith('\\'))
-            {
-                if (!checkWord(str)) {
-                    number = text.count(QRegExp("\\b" + str + "\\b"));
-                    l=-1;
-                    // underline all incorrect occurences of misspelled word
-                    for (int j=0;j < number; ++j)
-                    {
-                        l = text.indexOf(QRegExp("\\b" + str + "\\b"),l+1);
-                        if (l>=0)
-                            setFormat(l, str.length(), spellCheckFormat);
-                    } // for j
-                } // if spell chek error
-            } // if str.length > 1
-        } // for
-    } // if str.isEmpty
+    spellCheck(text);
 
     CSHighlighter::highlightBlock(text);
 }
@@ -125,83 +99,50 @@ void Highlighter::enableSpellChecking(const bool state)
 
 void Highlighter::spellCheck(const QString &text)
 {
-    if (spellCheckActive) {
-        // split text into words
-        QString str = text.simplified();
-        if (!str.isEmpty()) {
-            QStringList Checkliste = str.split(QRegExp("([^\\w,^\\\\]|(?=\\\\))+"),
-                                               QString::SkipEmptyParts);
-            int l,number;
-            // check all words
-            for (int i=0; i<Checkliste.size(); ++i) {
-                str = Checkliste.at(i);
-                if (str.length()>1 &&!str.startsWith('\\'))
-                {
-                    if (!checkWord(str)) {
-                        number = text.count(QRegExp("\\b" + str + "\\b"));
-                        l=-1;
-                        // underline all incorrect occurences of misspelled word
-                        for (int j=0;j < number; ++j)
-                        {
-                            l = text.indexOf(QRegExp("\\b" + str + "\\b"),l+1);
-                            if (l>=0)
-                                setFormat(l, str.length(), spellCheckFormat);
-                        } // for j
-                    } // if spell chek error
-                } // if str.length > 1
-            } // for
-        } // if str.isEmpty
-    } // initial check
+    if (!spellCheckActive)
+        return;
+
+    // underline what is already known, anything else is looked up in the background
+    bool pending = false;
+    for (const CDictionary::Word &word : CDictionary::Words(text)) {
+        bool correct;
+        if (!dictionary->isCached(text.mid(word.first, word.second), correct))
+            pending = true;
+        else if (!correct)
+            setFormat(word.first, word.second, spellCheckFormat);
+    }
+
+    const int block = currentBlock().blockNumber();
+    if (pending && pendingBlocks.value(block) != text) {
+        pendingBlocks.insert(block, text);
+        emit checkBlock(block, text);
+    }
+}
+
+void Highlighter::slot_blockChecked(int block, const QString &text)
+{
+    if (pendingBlocks.value(block) != text)
+        return; // superseded by a later edit
+
+    pendingBlocks.remove(block);
+
+    QTextBlock textBlock = document()->findBlockByNumber(block);
+    if (textBlock.isValid() && textBlock.text() == text)
+        rehighlightBlock(textBlock);
 }
 
 bool Highlighter::checkWord(QString word)
 {
-    int check;
-    /*switch(check=mWords.value(word,-1)){
-    case -1:
-    {
-        QByteArray encodedString;
-        encodedString = codec->fromUnicode(word);
-        check = pChecker->spell(encodedString.data());
-        mWords[word]=check;
-        break;
-    }
-    default:
-        break;
-    }
-        */
-    QByteArray encodedString;
-    encodedString = codec->fromUnicode(word);
-    check = pChecker->spell(encodedString.data());
-    return bool(check);
+    return !dictionary || dictionary->spell(word);
 }
 
 bool Highlighter::setDict(const QString SpellDic)
 {
     bool spell;
     if(SpellDic!=""){
-        //mWords.clear();
-        spell_dic=SpellDic.left(SpellDic.length()-4);
-        delete pChecker;
-        pChecker = new Hunspell(spell_dic.toLatin1()+".aff",spell_dic.toLatin1()+".dic");
-        spell_encoding=QString(pChecker->get_dic_encoding());
-        codec = QTextCodec::codecForName(spell_encoding.toLatin1());
-
-        QFileInfo fi(SpellDic);
-
-        if (fi.exists() && fi.isReadable()) spell=true;
-        else spell=false;
-
-        // get user config dictionary
-        QSettings setting;
-        QString filePath=QFileInfo(setting.fileName()).absoluteFilePath();
-        filePath=filePath+"/User_"+QFileInfo(spell_dic.toLatin1()+".dic").fileName();
-        std::cout << qPrintable(filePath) << std::endl;
-        fi=QFileInfo(filePath);
-        if (fi.exists() && fi.isReadable()){
-            pChecker->add_dic(filePath.toLatin1());
-        }
-        else filePath="";
+        dictionary = CDictionary::Acquire(SpellDic);
+        spell = dictionary->isValid();
+        createChecker();
 
         spellCheckFormat.setForeground(Qt::red);//faster Cursoroperation ...
         //spellCheckFormat.setUnderlineColor(QColor(Qt::red));
@@ -214,13 +155,9 @@ bool Highlighter::setDict(const QString SpellDic)
     return spell;
 }
 
+// the word has already been added to the shared dictionary
 void Highlighter::slot_addWord(QString word)
 {
-    std::cout << qPrintable(word) << std::endl;
-    QByteArray encodedString;
-    QString spell_encoding=QString(pChecker->get_dic_encoding());
-    QTextCodec *codec = QTextCodec::codecForName(spell_encoding.toLatin1());
-    encodedString = codec->fromUnicode(word);
-    pChecker->add(encodedString.data());
+    Q_UNUSED(word)
     rehighlight();
 }
@@ -49,7 +49,10 @@
 
 #include <QHash>
 #include <QTextCharFormat>
-#include "hunspell/hunspell.hxx"
+#include <QSharedPointer>
+
+class CDictionary;
+class CSpellChecker;
 
 class QTextDocument;
 
@@ -70,6 +73,12 @@ public:
 public slots:
 	void slot_addWord(QString word);
 
+signals:
+    void checkBlock(int block, const QString &text);
+
+private slots:
+    void slot_blockChecked(int block, const QString &text);
+
 protected:
     virtual void highlightBlock(const QString &text) override;
     void spellCheck(const QString &text);
@@ -93,11 +102,13 @@ private:
     QTextCharFormat quotationFormat;
     QTextCharFormat functionFormat;
 
-    QString spell_dic, spell_encoding;
-    Hunspell * pChecker;
+    void createChecker();
+
+    QSharedPointer<CDictionary> dictionary;
+    CSpellChecker *checker;
+    QHash<int, QString> pendingBlocks;
     bool spellCheckActive,spellerError;
     QTextCharFormat spellCheckFormat;
-    QTextCodec *codec;
 
 };
 
@@ -60,7 +60,9 @@ void CChoiceProperties::MoveDown()
 
 void CChoiceProperties::AddItem()
 {
-    m_choiceBubble->choices()->AddItem(new CChoice(m_choiceBubble->getPaletteAction(), m_choiceBubble->getFont(), m_choiceBubble));
+    CChoice *choice = new CChoice(m_choiceBubble->getPaletteAction(), m_choiceBubble->getFont(), m_choiceBubble);
+    choice->UpdateUID();
+    m_choiceBubble->choices()->AddItem(choice);
     m_view->edit(QModelIndex(m_view->model()->index(m_view->model()->rowCount() - 1, 0)));
 }
 
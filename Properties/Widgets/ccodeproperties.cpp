@@ -4,6 +4,7 @@
 #include "Misc/Bubbles/ccodeedit.h"
 #include "Misc/cshighlighter.h"
 #include "Misc/highlighter.h"
+#include "Misc/History/ceditbubblecommand.h"
 
 CCodeProperties::CCodeProperties(QWidget *parent)
     : CPropertiesWidget(parent)
@@ -35,7 +36,12 @@ void CCodeProperties::setBubble(CBubble *bubble)
 }
 
 void CCodeProperties::CodeChanged()
+{
+    CEditBubbleCommand::Push(m_codeBubble, CSymbolTable::Code, 0, m_codeEdit->toPlainText());
+}
+
+void CCodeProperties::BubbleTextChanged()
 {
     if(m_codeBubble)
-        m_codeBubble->setCode(m_codeEdit->toPlainText());
+        m_codeEdit->Refresh(m_codeBubble->getCode());
 }
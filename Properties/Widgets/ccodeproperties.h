@@ -23,6 +23,7 @@ private:
 
 private slots:
     void CodeChanged();
+    virtual void BubbleTextChanged() Q_DECL_OVERRIDE;
 
 };
 
@@ -7,6 +7,7 @@
 #include "Misc/Bubbles/cconditionedit.h"
 #include "Bubbles/cconditionbubble.h"
 #include "Misc/cshighlighter.h"
+#include "Misc/History/ceditbubblecommand.h"
 
 CConditionProperties::CConditionProperties(QWidget *parent)
     : CPropertiesWidget(parent), m_conditionBubble(0), m_conditionEdit(0)
@@ -49,8 +50,13 @@ void CConditionProperties::setBubble(CBubble *bbl)
 }
 
 void CConditionProperties::ConditionChanged()
+{
+    CEditBubbleCommand::Push(m_conditionBubble, CSymbolTable::Condition, 0, m_conditionEdit->toPlainText());
+}
+
+void CConditionProperties::BubbleTextChanged()
 {
     if(m_conditionBubble)
-        m_conditionBubble->setCondition(m_conditionEdit->toPlainText());
+        m_conditionEdit->Refresh(m_conditionBubble->getCondition());
 }
 
@@ -26,6 +26,7 @@ signals:
 
 protected slots:
     void ConditionChanged();
+    virtual void BubbleTextChanged() Q_DECL_OVERRIDE;
 };
 
 #endif // CCONDITIONPROPERTIES_H
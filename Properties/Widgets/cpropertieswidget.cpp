@@ -78,6 +78,12 @@ void CPropertiesWidget::setBubble(CBubble *bbl)
 {
     m_bubble = bbl;
 
+    if(m_watched)
+        disconnect(m_watched, SIGNAL(TextChanged()), this, SLOT(BubbleTextChanged()));
+    m_watched = bbl;
+    if(m_watched)
+        connect(m_watched, SIGNAL(TextChanged()), this, SLOT(BubbleTextChanged()));
+
     if(m_bubble)
     {
         setEnabled(true);
@@ -119,3 +125,6 @@ void CPropertiesWidget::LockedChanged(bool locked)
         m_orderEdit->setEnabled(locked);
     }
 }
+
+void CPropertiesWidget::BubbleTextChanged()
+{}
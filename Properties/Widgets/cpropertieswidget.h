@@ -5,6 +5,7 @@
 #include <QVBoxLayout>
 #include <QLineEdit>
 #include <QCheckBox>
+#include <QPointer>
 
 QT_BEGIN_NAMESPACE
 class QStringListModel;
@@ -36,6 +37,13 @@ protected:
 
     QVBoxLayout *m_layout;
 
+private:
+    QPointer<CBubble> m_watched;
+
+protected slots:
+    /// @brief reloads the text of the bubble after it changed elsewhere, e.g. through undo
+    virtual void BubbleTextChanged();
+
 signals:
 
 public slots:
@@ -13,6 +13,7 @@
 #include "Misc/Bubbles/cstartheredelegate.h"
 #include "Bubbles/cstartherebubble.h"
 #include "Misc/Bubbles/ccodeedit.h"
+#include "Misc/History/ceditbubblecommand.h"
 
 CStartHereProperties::CStartHereProperties(QWidget *parent)
     : QWidget(parent), m_bubble(Q_NULLPTR)
@@ -51,6 +52,12 @@ void CStartHereProperties::setBubble(CBubble *bbl)
 {
     m_bubble = dynamic_cast<CStartHereBubble *>(bbl);
 
+    if(m_watched)
+        disconnect(m_watched, SIGNAL(TextChanged()), this, SLOT(BubbleTextChanged()));
+    m_watched = m_bubble;
+    if(m_watched)
+        connect(m_watched, SIGNAL(TextChanged()), this, SLOT(BubbleTextChanged()));
+
     if(m_bubble)
     {
         m_label->setText(m_bubble->getLabel());
@@ -82,7 +89,12 @@ void CStartHereProperties::LabelChanged(QString label)
 }
 
 void CStartHereProperties::CodeChanged()
+{
+    CEditBubbleCommand::Push(m_bubble, CSymbolTable::StartHereCode, 0, m_customCodeEdit->toPlainText());
+}
+
+void CStartHereProperties::BubbleTextChanged()
 {
     if(m_bubble)
-        m_bubble->setCustomCode(m_customCodeEdit->toPlainText());
+        m_customCodeEdit->Refresh(m_bubble->customCode());
 }
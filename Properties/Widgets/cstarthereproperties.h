@@ -2,6 +2,7 @@
 #define CSTARTHEREPROPERTIES_H
 
 #include <QWidget>
+#include <QPointer>
 
 QT_BEGIN_NAMESPACE
 class QTableView;
@@ -27,12 +28,17 @@ private:
     CStartHereBubble *m_bubble;
     CCodeEdit *m_customCodeEdit;
 
+    QPointer<CBubble> m_watched;
+
 public slots:
     void AddItem();
     void RemoveItem();
 
     void LabelChanged(QString label);
     void CodeChanged();
+
+private slots:
+    void BubbleTextChanged();
 };
 
 #endif // CSTARTHEREPROPERTIES_H
@@ -9,6 +9,7 @@
 #include "Misc/ctextedit.h"
 #include "Misc/qactionbutton.h"
 #include "Bubbles/cstorybubble.h"
+#include "Misc/History/ceditbubblecommand.h"
 
 #include "cgraphicsview.h"
 
@@ -127,9 +128,14 @@ void CStoryProperties::UpdateModel()
 
 
 void CStoryProperties::StoryChanged()
+{
+    CEditBubbleCommand::Push(m_storyBubble, CSymbolTable::Story, 0, m_storyEdit->toPlainText());
+}
+
+void CStoryProperties::BubbleTextChanged()
 {
     if(m_storyBubble)
-        m_storyBubble->setStory(m_storyEdit->toPlainText());
+        m_storyEdit->Refresh(m_storyBubble->getStory());
 }
 
 void CStoryProperties::BoldTriggered()
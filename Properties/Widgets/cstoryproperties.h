@@ -35,6 +35,7 @@ signals:
 
 protected slots:
     void StoryChanged();
+    virtual void BubbleTextChanged() Q_DECL_OVERRIDE;
 
     void BoldTriggered();
     void ItalicTriggered();
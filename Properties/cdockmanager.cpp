@@ -6,6 +6,7 @@
 #include "cpropertiesmanager.h"
 #include "cprojectview.h"
 #include "cvariablesview.h"
+#include "cusagesview.h"
 
 #include "Misc/chronicler.h"
 using Chronicler::shared;
@@ -27,6 +28,7 @@ CDockManager::CDockManager(QWidget *parent)
 
     m_tabView->addTab(shared().projectView, "Project");
     m_tabView->addTab(shared().variablesView, "Variables");
+    m_tabView->addTab(new CUsagesView(), "Usages");
     m_tabView->addTab(m_properties, "Bubble");
 
     QVBoxLayout *layout = new QVBoxLayout();
@@ -228,7 +228,8 @@ void CProjectView::SaveToFile(QSaveFile &file)
     QByteArray ba;
     QDataStream ds(&ba, QIODevice::WriteOnly);
 
-    ds << shared().ProgramVersion << m_title->text() << m_author->text() << *(shared().paletteButton) << m_sceneModel->rowCount();
+    ds << shared().ProgramVersion << m_title->text() << m_author->text() << CBubble::nextUID()
+       << *(shared().paletteButton) << m_sceneModel->rowCount();
     for(CGraphicsView *view : m_sceneModel->views())
         ds << *(view->cScene());
 
@@ -297,9 +298,12 @@ void CProjectView::OpenProject(QString filepath)
     int num_scenes;
     QString project_title;
     QString project_author;
+    t_uid next_uid = 0;
 
     ds >> m_version;
-    if(m_version > "0.8.6.0")
+    if(m_version >= "0.11.2.0")
+        ds >> project_title >> project_author >> next_uid >> *(shared().paletteButton) >> num_scenes;
+    else if(m_version > "0.8.6.0")
         ds >> project_title >> project_author >> *(shared().paletteButton) >> num_scenes;
     else if(m_version > "0.8.1.0")
         ds >> project_title >> *(shared().paletteButton) >> num_scenes;
@@ -322,6 +326,17 @@ void CProjectView::OpenProject(QString filepath)
 
     ds >> *(shared().variablesView);
 
+    // older projects saved addresses as UIDs, number their bubbles in order instead
+    if(next_uid == 0)
+    {
+        CBubble::setNextUID(1);
+        for(CGraphicsView *view : m_sceneModel->views())
+            for(CBubble *bubble : view->cScene()->bubbles())
+                bubble->UpdateUID();
+    }
+    else
+        CBubble::setNextUID(next_uid);
+
     shared().dock->show();
     shared().pointerToolBar->show();
     shared().dock->setWindowTitle(m_path);
@@ -389,8 +404,10 @@ void CProjectView::ImportChoiceScriptScene()
     m_sceneModel->AddItem(csdata.getViews().first());
 
     for(const CVariable &var : csdata.getVariables())
-        if(!shared().variablesView->model()->variables().contains(var))
+    {
+        if(!shared().variablesView->model()->contains(var))
             shared().variablesView->model()->AddItem(var);
+    }
 
 }
 
@@ -426,6 +443,7 @@ void CProjectView::CloseProject()
 
     for(CGraphicsView *view : m_sceneModel->views())
     {
+        CGraphicsScene::Batch batch(view->cScene());
         QList<CBubble *> bubbles = view->cScene()->bubbles();
 
         for(CBubble *bbl : bubbles)
@@ -435,6 +453,8 @@ void CProjectView::CloseProject()
     m_sceneModel->Reset();
     shared().variablesView->Reset();
 
+    CBubble::setNextUID(1);
+
     shared().dock->hide();
     shared().pointerToolBar->hide();
     shared().showHomepageAction->trigger();
@@ -504,37 +524,6 @@ QList<CGraphicsView *> CProjectView::getViews()
     return m_sceneModel->views();
 }
 
-CBubble *CProjectView::BubbleWithUID(uint uid)
-{
-    CBubble *bubble = Q_NULLPTR;
-
-    for(CGraphicsView *view : m_sceneModel->views())
-    {
-        for(QGraphicsItem *item : view->items())
-        {
-            if((bubble = dynamic_cast<CBubble *>(item)) && (bubble->getUID() == uid))
-                return bubble;
-        }
-    }
-
-    return Q_NULLPTR;
-}
-
-CBubble *CProjectView::BubbleWithUID(uint uid, QGraphicsScene *scene)
-{
-    if(scene)
-    {
-        CBubble *bubble = Q_NULLPTR;
-        for(QGraphicsItem *item : scene->items())
-        {
-            if((bubble = dynamic_cast<CBubble *>(item)) && (bubble->getUID() == uid))
-                return bubble;
-        }
-    }
-
-    return Q_NULLPTR;
-}
-
 const CVersion &CProjectView::getVersion() const
 {
     return m_version;
@@ -559,10 +548,10 @@ QString CProjectView::BubbleToChoiceScript(const QList<CBubble *> &bubbles, QLis
         // ------------ Debug Start Here bubble ------------
         if(debugStart && debugStart->link() && bubble == debugStart->link()->to())
         {
-            const QList<CVariable> variables = debugStart->model()->variables();
+            const QVector<CVariable> &variables = debugStart->model()->variables();
 
             cs += indent + "\n*label " + MakeLabel(debugStart, {});
-            for(CVariable v : variables)
+            for(const CVariable &v : variables)
                 cs += indent + "*set " + v.name() + " " + v.data() + "\n";
 
             cs += indent + debugStart->customCode().replace("\n", "\n" + indent) + "\n";
@@ -686,10 +675,10 @@ QString CProjectView::BubbleToChoiceScript(const QList<CBubble *> &bubbles, QLis
         // ------------ Debug Start Here bubble ------------
         if(debugStart && debugStart->link() && bubble == debugStart->link()->to())
         {
-            const QList<CVariable> variables = debugStart->model()->variables();
+            const QVector<CVariable> &variables = debugStart->model()->variables();
 
             cs += indent + "\n*label " + MakeLabel(debugStart, {});
-            for(CVariable v : variables)
+            for(const CVariable &v : variables)
                 cs += indent + "*set " + v.name() + " " + v.data() + "\n";
 
             cs += indent + debugStart->customCode().replace("\n", "\n" + indent) + "\n";
@@ -893,14 +882,14 @@ QString CProjectView::MakeLabel(CBubble *bubble, const QList<CBubble *> &bubbles
 {
     QString label = bubble->getLabel().replace(" ", "_");
     if(!label.length())
-        label = "bubble_" + QString::number(bubble->GenerateUID());
+        label = "bubble_" + QString::number(bubble->getUID());
     else
     {
         for(CBubble *b : bubbles)
         {
             if(b != bubble && b->getLabel() == bubble->getLabel())
             {
-                label += "_" + QString::number(bubble->GenerateUID());
+                label += "_" + QString::number(bubble->getUID());
                 break;
             }
         }
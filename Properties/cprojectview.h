@@ -36,9 +36,6 @@ public:
 
     QList<CGraphicsView *> getViews();
 
-    CBubble *BubbleWithUID(uint uid);
-    CBubble *BubbleWithUID(uint uid, QGraphicsScene *scene);
-
     const CVersion &getVersion() const;
 
     CSceneModel *model();
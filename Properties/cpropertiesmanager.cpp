@@ -12,41 +12,16 @@
 
 
 CPropertiesManager::CPropertiesManager(QWidget *parent)
-    : QWidget(parent)
+    : QWidget(parent), m_storyProperties(Q_NULLPTR), m_conditionProperties(Q_NULLPTR), m_choiceProperties(Q_NULLPTR),
+      m_actionProperties(Q_NULLPTR), m_codeProperties(Q_NULLPTR), m_startHereProperties(Q_NULLPTR)
 {
-    m_storyProperties = new CStoryProperties(parent);
-    m_storyProperties->setEnabled(false);
-
-    m_conditionProperties = new CConditionProperties(parent);
-    m_conditionProperties->setEnabled(false);
-    m_conditionProperties->hide();
-
-    m_choiceProperties = new CChoiceProperties(parent);
-    m_choiceProperties->setEnabled(false);
-    m_choiceProperties->hide();
-
-    m_actionProperties = new CActionProperties(parent);
-    m_actionProperties->setEnabled(false);
-    m_actionProperties->hide();
-
-    m_codeProperties = new CCodeProperties(parent);
-    m_codeProperties->setEnabled(false);
-    m_codeProperties->hide();
-
-    m_startHereProperties = new CStartHereProperties(parent);
-    m_startHereProperties->setEnabled(false);
-    m_startHereProperties->hide();
-
-    
     QVBoxLayout *layout = new QVBoxLayout(this);
-    layout->addWidget(m_storyProperties);
-    layout->addWidget(m_conditionProperties);
-    layout->addWidget(m_choiceProperties);
-    layout->addWidget(m_actionProperties);
-    layout->addWidget(m_codeProperties);
-    layout->addWidget(m_startHereProperties);
     setLayout(layout);
 
+    // the other panels are created on demand, the story panel is shown while nothing is selected
+    panel(m_storyProperties)->setEnabled(false);
+    m_storyProperties->show();
+
 //    QPalette Pal(palette());
 //    Pal.setColor(QPalette::Background, Qt::gray);//QColor(86,96,123));
 //    setAutoFillBackground(true);
@@ -65,12 +40,8 @@ void CPropertiesManager::setBubble(CBubble *bbl)
 {
     if(bbl)
     {
-        m_storyProperties->hide();
-        m_conditionProperties->hide();
-        m_choiceProperties->hide();
-        m_actionProperties->hide();
-        m_codeProperties->hide();
-        m_startHereProperties->hide();
+        for(QWidget *w : m_panels)
+            w->hide();
 
         switch(bbl->getType())
         {
@@ -78,32 +49,32 @@ void CPropertiesManager::setBubble(CBubble *bbl)
             break;
 
         case Chronicler::StoryBubble:
-            m_storyProperties->setBubble(bbl);
+            panel(m_storyProperties)->setBubble(bbl);
             m_storyProperties->show();
         break;
 
         case Chronicler::ChoiceBubble:
-            m_choiceProperties->setBubble(bbl);
+            panel(m_choiceProperties)->setBubble(bbl);
             m_choiceProperties->show();
         break;
 
         case Chronicler::ActionBubble:
-            m_actionProperties->setBubble(bbl);
+            panel(m_actionProperties)->setBubble(bbl);
             m_actionProperties->show();
         break;
 
         case Chronicler::ConditionBubble:
-            m_conditionProperties->setBubble(bbl);
+            panel(m_conditionProperties)->setBubble(bbl);
             m_conditionProperties->show();
         break;
 
         case Chronicler::CodeBubble:
-            m_codeProperties->setBubble(bbl);
+            panel(m_codeProperties)->setBubble(bbl);
             m_codeProperties->show();
             break;
 
         case Chronicler::StartHereBubble:
-            m_startHereProperties->setBubble(bbl);
+            panel(m_startHereProperties)->setBubble(bbl);
             m_startHereProperties->show();
             break;
 
@@ -113,11 +84,18 @@ void CPropertiesManager::setBubble(CBubble *bbl)
     }
     else
     {
-        m_storyProperties->setBubble(Q_NULLPTR);
-        m_conditionProperties->setBubble(Q_NULLPTR);
-        m_choiceProperties->setBubble(Q_NULLPTR);
-        m_actionProperties->setBubble(Q_NULLPTR);
-        m_codeProperties->setBubble(Q_NULLPTR);
-        m_startHereProperties->setBubble(Q_NULLPTR);
+        // panels that were never created have nothing to clear
+        if(m_storyProperties)
+            m_storyProperties->setBubble(Q_NULLPTR);
+        if(m_conditionProperties)
+            m_conditionProperties->setBubble(Q_NULLPTR);
+        if(m_choiceProperties)
+            m_choiceProperties->setBubble(Q_NULLPTR);
+        if(m_actionProperties)
+            m_actionProperties->setBubble(Q_NULLPTR);
+        if(m_codeProperties)
+            m_codeProperties->setBubble(Q_NULLPTR);
+        if(m_startHereProperties)
+            m_startHereProperties->setBubble(Q_NULLPTR);
     }
 }
@@ -2,6 +2,7 @@
 #define CPROPERTIESVIEW_H
 
 #include <QWidget>
+#include <QLayout>
 
 QT_BEGIN_NAMESPACE
 class QStringListModel;
@@ -23,6 +24,23 @@ public:
     void setBubble(CBubble *bbl);
 
 private:
+    /// @brief creates the panel the first time a bubble of its type is selected
+    template<typename T>
+    T *panel(T *&properties)
+    {
+        if(!properties)
+        {
+            properties = new T(this);
+            properties->hide();
+            layout()->addWidget(properties);
+            m_panels.append(properties);
+        }
+
+        return properties;
+    }
+
+    QList<QWidget *> m_panels;
+
     CStoryProperties *m_storyProperties;
     CConditionProperties *m_conditionProperties;
     CChoiceProperties *m_choiceProperties;
@@ -0,0 +1,206 @@
+#include "cusagesview.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QComboBox>
+#include <QPushButton>
+#include <QListWidget>
+#include <QTabWidget>
+
+#include <algorithm>
+
+#include "Properties/cvariablesview.h"
+#include "Properties/cprojectview.h"
+#include "Misc/Variables/cvariablesmodel.h"
+#include "Misc/Variables/csymboltable.h"
+#include "cgraphicsview.h"
+#include "cgraphicsscene.h"
+#include "Bubbles/cbubble.h"
+
+#include "Misc/chronicler.h"
+using Chronicler::shared;
+
+static QString accessName(CSymbolTable::Access access)
+{
+    switch(access)
+    {
+    case CSymbolTable::Write:
+        return CUsagesView::tr("write");
+    case CSymbolTable::ReadWrite:
+        return CUsagesView::tr("read/write");
+    case CSymbolTable::Debug:
+        return CUsagesView::tr("debug");
+    default:
+        return CUsagesView::tr("read");
+    }
+}
+
+
+CUsagesView::CUsagesView(QWidget *parent)
+    : QWidget(parent)
+{
+    m_variable = new QComboBox(this);
+    m_variable->setEditable(true);
+    m_variable->setInsertPolicy(QComboBox::NoInsert);
+    m_variable->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+
+    QPushButton *findUsages = new QPushButton(tr("Find usages"), this);
+    connect(findUsages, SIGNAL(clicked(bool)), this, SLOT(FindUsages()));
+
+    QPushButton *findUnused = new QPushButton(tr("Unused"), this);
+    connect(findUnused, SIGNAL(clicked(bool)), this, SLOT(FindUnused()));
+
+    QPushButton *findNeverRead = new QPushButton(tr("Never read"), this);
+    findNeverRead->setToolTip(tr("Variables that are written but never read"));
+    connect(findNeverRead, SIGNAL(clicked(bool)), this, SLOT(FindNeverRead()));
+
+    m_results = new QListWidget(this);
+    m_results->setAlternatingRowColors(true);
+    connect(m_results, SIGNAL(itemActivated(QListWidgetItem*)), this, SLOT(ResultActivated(QListWidgetItem*)));
+
+    QHBoxLayout *hl_find = new QHBoxLayout();
+    hl_find->addWidget(m_variable);
+    hl_find->addWidget(findUsages);
+
+    QHBoxLayout *hl_queries = new QHBoxLayout();
+    hl_queries->addWidget(findUnused);
+    hl_queries->addWidget(findNeverRead);
+    hl_queries->addStretch(1);
+
+    QVBoxLayout *vl_main = new QVBoxLayout(this);
+    vl_main->addLayout(hl_find);
+    vl_main->addLayout(hl_queries);
+    vl_main->addWidget(m_results);
+}
+
+void CUsagesView::showEvent(QShowEvent *)
+{
+    UpdateVariables();
+}
+
+void CUsagesView::UpdateVariables()
+{
+    if(!shared().variablesView)
+        return;
+
+    QStringList names = shared().variablesView->model()->names().toList();
+    std::sort(names.begin(), names.end());
+
+    const QString current = m_variable->currentText();
+    m_variable->clear();
+    m_variable->addItems(names);
+    m_variable->setEditText(current);
+}
+
+void CUsagesView::FindUsages()
+{
+    m_results->clear();
+    m_bubbles.clear();
+
+    const QString name = m_variable->currentText().trimmed();
+    if(name.isEmpty() || !shared().symbolTable)
+        return;
+
+    for(const CSymbolTable::Usage &u : shared().symbolTable->usages(name))
+    {
+        // the line the variable is used on
+        const QString text = CSymbolTable::Text(u.bubble, u.field, u.index);
+        const int lineStart = text.lastIndexOf('\n', u.start) + 1;
+        int lineEnd = text.indexOf('\n', u.start);
+        if(lineEnd == -1)
+            lineEnd = text.length();
+
+        CGraphicsScene *scene = dynamic_cast<CGraphicsScene *>(u.bubble->scene());
+        const QString bubble = u.bubble->getLabel().isEmpty() ? tr("Bubble") : u.bubble->getLabel();
+
+        m_results->addItem(QString("%1 / %2 [%3]: %4")
+                           .arg(scene ? scene->name() : QString())
+                           .arg(bubble)
+                           .arg(accessName(u.access))
+                           .arg(text.mid(lineStart, lineEnd - lineStart).trimmed()));
+        m_bubbles.append(u.bubble);
+    }
+
+    if(m_results->count() == 0)
+    {
+        m_results->addItem(tr("No usages of %1").arg(name));
+        m_bubbles.append(Q_NULLPTR);
+    }
+}
+
+void CUsagesView::FindUnused()
+{
+    m_results->clear();
+    m_bubbles.clear();
+
+    if(!shared().variablesView || !shared().symbolTable)
+        return;
+
+    QStringList names = shared().variablesView->model()->names().toList();
+    std::sort(names.begin(), names.end());
+
+    for(const QString &name : names)
+    {
+        if(!shared().symbolTable->reads(name) && !shared().symbolTable->writes(name))
+        {
+            m_results->addItem(name);
+            m_bubbles.append(Q_NULLPTR);
+        }
+    }
+}
+
+void CUsagesView::FindNeverRead()
+{
+    m_results->clear();
+    m_bubbles.clear();
+
+    if(!shared().variablesView || !shared().symbolTable)
+        return;
+
+    QStringList names = shared().variablesView->model()->names().toList();
+    std::sort(names.begin(), names.end());
+
+    for(const QString &name : names)
+    {
+        if(shared().symbolTable->writes(name) && !shared().symbolTable->reads(name))
+        {
+            m_results->addItem(name);
+            m_bubbles.append(Q_NULLPTR);
+        }
+    }
+}
+
+void CUsagesView::ResultActivated(QListWidgetItem *item)
+{
+    const int row = m_results->row(item);
+    if(row < 0 || row >= m_bubbles.length())
+        return;
+
+    CBubble *bubble = m_bubbles.at(row);
+
+    // a variable, list where it is used
+    if(!bubble)
+    {
+        if(shared().variablesView->model()->names().contains(item->text()))
+        {
+            m_variable->setEditText(item->text());
+            FindUsages();
+        }
+        return;
+    }
+
+    for(CGraphicsView *view : shared().projectView->getViews())
+    {
+        if(view->cScene() == bubble->scene())
+        {
+            if(shared().sceneTabs->indexOf(view) == -1)
+                shared().sceneTabs->addTab(view, view->cScene()->name());
+            shared().sceneTabs->setCurrentWidget(view);
+
+            view->cScene()->clearSelection();
+            bubble->setSelected(true);
+            view->centerOn(bubble);
+            break;
+        }
+    }
+}
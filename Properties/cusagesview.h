@@ -0,0 +1,45 @@
+#ifndef CUSAGESVIEW_H
+#define CUSAGESVIEW_H
+
+#include <QWidget>
+#include <QPointer>
+
+QT_BEGIN_NAMESPACE
+class QComboBox;
+class QListWidget;
+class QListWidgetItem;
+QT_END_NAMESPACE
+
+class CBubble;
+
+/**
+ * @brief Answers where variables are used, and which ones are never used or never read.
+ */
+class CUsagesView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit CUsagesView(QWidget *parent = Q_NULLPTR);
+
+protected:
+    virtual void showEvent(QShowEvent *) Q_DECL_OVERRIDE;
+
+private:
+    QComboBox   *m_variable;
+    QListWidget *m_results;
+
+    // bubble of each result row, empty for rows listing variables
+    QList<QPointer<CBubble>> m_bubbles;
+
+private slots:
+    void UpdateVariables();
+
+    void FindUsages();
+    void FindUnused();
+    void FindNeverRead();
+
+    void ResultActivated(QListWidgetItem *item);
+};
+
+#endif // CUSAGESVIEW_H
@@ -95,7 +95,7 @@ QDataStream &CVariablesView::Deserialize(QDataStream &ds, const CVersion &versio
 QDataStream &CVariablesView::Serialize(QDataStream &ds) const
 {
     ds << static_cast<qint64>(m_model->rowCount());
-    for(CVariable &v : m_model->variables())
+    for(const CVariable &v : m_model->variables())
         ds << v;
 
     return ds;
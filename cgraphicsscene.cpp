@@ -39,12 +39,15 @@
 #include "Misc/History/cremovebubblescommand.h"
 #include "Misc/History/cresizebubblecommand.h"
 
+#include "Misc/Variables/csymboltable.h"
+
 #include "Misc/chronicler.h"
 using Chronicler::Anchor;
 using Chronicler::shared;
 
 CGraphicsScene::CGraphicsScene(bool create_start, const QString &name, QObject *parent)
-    : QGraphicsScene(parent), m_name(name), m_line(0), m_rubberBand(false)
+    : QGraphicsScene(parent), m_name(name), m_line(0), m_rubberBand(false),
+      m_batch(0), m_batchChanges(0), m_indexSuspended(false), m_labelsChanged(false)
 {
     float maxsize = 25000.0;
     float minsize = -maxsize/2;
@@ -56,7 +59,6 @@ CGraphicsScene::CGraphicsScene(bool create_start, const QString &name, QObject *
     addItem(m_line);
 
     connect(this, SIGNAL(itemSelected(QGraphicsItem*)), this, SLOT(ItemSelected(QGraphicsItem*)));
-    connect(this, SIGNAL(changed(QList<QRectF>)), this, SLOT(UpdateSceneRect()));
 
     if(create_start)
         m_startBubble = dynamic_cast<CStartBubble *>(AddBubble(Chronicler::StartBubble, sceneRect().center(), false));
@@ -65,13 +67,22 @@ CGraphicsScene::CGraphicsScene(bool create_start, const QString &name, QObject *
 void CGraphicsScene::setFont(const QFont &font)
 {
     m_font = font;
+    ApplyRemovals();
 
-    for(QGraphicsItem *item : items())
+    // Relayout every bubble quietly, connections and the scene rect
+    // are brought up to date in one go afterwards.
+    for(CBubble *bbl : m_bubbles)
     {
-        CBubble *bbl = dynamic_cast<CBubble *>(item);
-        if(bbl)
-            bbl->setFont(m_font);
+        const bool blocked = bbl->blockSignals(true);
+        bbl->setFont(m_font);
+        bbl->blockSignals(blocked);
     }
+
+    for(CConnection *connection : m_connections)
+        connection->UpdatePosition();
+
+    UpdateSceneRect();
+    update();
 }
 
 QString CGraphicsScene::name()
@@ -92,11 +103,34 @@ CLine *CGraphicsScene::getLine()
 
 QList<CBubble *> CGraphicsScene::bubbles()
 {
+    ApplyRemovals();
     return m_bubbles;
 }
 
+/**
+ * @brief Table of the given bubbles and their choices by UID, to connect them in a single pass.
+ */
+QHash<t_uid, CBubble *> CGraphicsScene::BubblesByUID(const QList<CBubble *> &bubbles)
+{
+    QHash<t_uid, CBubble *> uids;
+    uids.reserve(bubbles.length());
+
+    for(CBubble *bubble : bubbles)
+    {
+        uids.insert(bubble->getUID(), bubble);
+
+        CChoiceBubble *choiceBubble = dynamic_cast<CChoiceBubble *>(bubble);
+        if(choiceBubble)
+            for(CChoice *choice : choiceBubble->choiceBubbles())
+                uids.insert(choice->getUID(), choice);
+    }
+
+    return uids;
+}
+
 QList<CConnection *> CGraphicsScene::connections()
 {
+    ApplyRemovals();
     return m_connections;
 }
 
@@ -105,6 +139,7 @@ CBubble *CGraphicsScene::BubbleAt(const QPointF &point, bool choiceAllowed)
 {
     CBubble *bubble = 0;
 
+    ApplyRemovals();
     for(CBubble *current : m_bubbles)
     {
         if(current->polygon().containsPoint(point - current->scenePos(), Qt::WindingFill))
@@ -135,8 +170,15 @@ CBubble *CGraphicsScene::BubbleAt(const QPointF &point, bool choiceAllowed)
 
 QDataStream &CGraphicsScene::Serialize(QDataStream &ds) const
 {
-    ds << m_name << static_cast<qint32>(m_bubbles.length());
+    // bubbles taken out in a running batch are still listed until it ends
+    QList<CBubble *> bubbles;
+    bubbles.reserve(m_bubbles.length());
     for(CBubble *bbl : m_bubbles)
+        if(!m_removedBubbles.contains(bbl))
+            bubbles.append(bbl);
+
+    ds << m_name << static_cast<qint32>(bubbles.length());
+    for(CBubble *bbl : bubbles)
         ds << *bbl;
 
     return ds;
@@ -146,6 +188,8 @@ QDataStream &CGraphicsScene::Deserialize(QDataStream &ds, const Chronicler::CVer
 {
     Q_UNUSED(version)
 
+    Batch batch(this);
+
     qint32 len, t;
     CBubble *bbl;
     ds >> len;
@@ -153,15 +197,18 @@ QDataStream &CGraphicsScene::Deserialize(QDataStream &ds, const Chronicler::CVer
     for(int i = 0; i < len; ++i)
     {
         ds >> t;
-        bbl = AddBubble(Chronicler::BubbleType(t), QPointF(), false);
+        bbl = CreateBubble(Chronicler::BubbleType(t), QPointF());
+        AddBubble(bbl);
         ds >> *bbl;
 
         if(bbl->getType() == Chronicler::StartBubble)
             m_startBubble = dynamic_cast<CStartBubble*>(bbl);
     }
 
+    ApplyRemovals();
+    const QHash<t_uid, CBubble *> uids = BubblesByUID(m_bubbles);
     for(CConnection *connection : m_connections)
-        connection->ConnectToUIDs();
+        connection->ConnectToUIDs(uids);
 
     for(CBubble *bbl : m_bubbles)
         bbl->setSelected(false);
@@ -181,13 +228,17 @@ void CGraphicsScene::ItemSelected(QGraphicsItem *selectedItem)
             shared().debugAction->setEnabled(bbl != Q_NULLPTR);
         }
 
-        // decrease all z values by a ridiculously small number
-        // to preserve current stacking order & help prevent float overflow
-        foreach (QGraphicsItem *item, items())
-            item->setZValue(item->zValue() - qPow(1, -10));
+        // restacking walks every item, leave it out while a batch selects its bubbles
+        if(m_batch == 0)
+        {
+            // decrease all z values by a ridiculously small number
+            // to preserve current stacking order & help prevent float overflow
+            foreach (QGraphicsItem *item, items())
+                item->setZValue(item->zValue() - qPow(1, -10));
 
-        // bring the selected item to the front
-        selectedItem->setZValue(1);
+            // bring the selected item to the front
+            selectedItem->setZValue(1);
+        }
     }
 }
 
@@ -213,21 +264,43 @@ void CGraphicsScene::DeselectAll()
         itm->setSelected(false);
 }
 
+void CGraphicsScene::ItemGeometryChanged()
+{
+    CBubble *bubble = qobject_cast<CBubble *>(sender());
+    if(bubble)
+        GrowSceneRect(bubble->sceneBoundingRect());
+}
+
+// Full pass over every bubble, only needed after bulk changes
 void CGraphicsScene::UpdateSceneRect()
 {
-    if(views().length())
-    {
-        QRectF ib = itemsBoundingRect();
-        QRectF sb = sceneRect();
-        //        QRectF vb = views().first()->visibleRegion().boundingRect();
-        qreal p = 1000;
+    QRectF bounds;
+    ApplyRemovals();
+    for(CBubble *bbl : m_bubbles)
+        bounds |= bbl->sceneBoundingRect();
 
-        setSceneRect(QRectF(QPointF(qMin(ib.left() - p, sb.left()), qMin(ib.top() - p, sb.top())),
-                            QPointF(qMax(ib.right() + p, sb.right()), qMax(ib.bottom() + p, sb.bottom()))));
+    m_bubblesRect = QRectF();
+    if(!bounds.isNull())
+        GrowSceneRect(bounds);
+}
 
-        //        if(selectedItems().length())
-        //            views().first()->ensureVisible(selectedItems().first(), 100, 100);
+// The scene rect only ever grows, so a single item's bounds are enough to update it
+void CGraphicsScene::GrowSceneRect(const QRectF &rect)
+{
+    if(m_batch > 0)
+    {
+        m_batchRect |= rect;
+        return;
     }
+
+    m_bubblesRect |= rect;
+
+    const qreal p = 1000;
+    const QRectF sb = sceneRect();
+    const QRectF padded = rect.adjusted(-p, -p, p, p);
+
+    if(!sb.contains(padded))
+        setSceneRect(sb | padded);
 }
 
 void CGraphicsScene::mousePressEvent(QGraphicsSceneMouseEvent *event)
@@ -419,7 +492,10 @@ void CGraphicsScene::keyReleaseEvent(QKeyEvent *event)
 }
 
 
-CBubble * CGraphicsScene::AddBubble(BubbleType type, const QPointF &pos, bool shift)
+/**
+ * @brief Constructs a bubble of the given type with the scene's font, without adding it.
+ */
+CBubble *CGraphicsScene::CreateBubble(BubbleType type, const QPointF &pos)
 {
     CBubble *bubble = Q_NULLPTR;
     if(type == Chronicler::StoryBubble)
@@ -437,8 +513,16 @@ CBubble * CGraphicsScene::AddBubble(BubbleType type, const QPointF &pos, bool sh
     else if(type == Chronicler::StartHereBubble)
         bubble = new CStartHereBubble(pos, shared().defaultStart, m_font);
 
+    return bubble;
+}
+
+CBubble * CGraphicsScene::AddBubble(BubbleType type, const QPointF &pos, bool shift)
+{
+    CBubble *bubble = CreateBubble(type, pos);
     if(bubble)
     {
+        // only a bubble created here is new, the others read or copy their UID
+        bubble->UpdateUID();
         shared().history->push(new CAddBubblesCommand(this, {bubble}));
 
         if(!shift)
@@ -451,31 +535,47 @@ CBubble * CGraphicsScene::AddBubble(BubbleType type, const QPointF &pos, bool sh
 void CGraphicsScene::AddBubble(CBubble *bubble)
 {
     addItem(bubble);
-    m_bubbles.append(bubble);
+
+    // a bubble taken out in the current batch is still listed
+    if(!m_removedBubbles.remove(bubble))
+        m_bubbles.append(bubble);
+
+    if(m_batch > 0)
+        BatchChanged();
 
     connect(bubble, SIGNAL(Selected(QGraphicsItem*)), this, SIGNAL(itemSelected(QGraphicsItem*)));
     connect(bubble, SIGNAL(ShapeChanged(QRectF,QRectF)), this, SLOT(ItemShapeChanged(QRectF,QRectF)));
+    connect(bubble, SIGNAL(PositionOrShapeChanged()), this, SLOT(ItemGeometryChanged()));
+    connect(bubble, SIGNAL(LabelsChanged()), this, SLOT(ItemLabelsChanged()));
+
+    GrowSceneRect(bubble->sceneBoundingRect());
+    IndexLabels(bubble);
+
+    if(shared().symbolTable)
+        shared().symbolTable->AddBubble(bubble);
 
     emit itemInserted(bubble);
 }
 
 CConnection *CGraphicsScene::AddConnection(CBubble *start, CBubble *end, Anchor start_anchor, Anchor end_anchor)
 {
-    m_connections.append(new CConnection(start, end, start_anchor, end_anchor, this));
+    CConnection *connection = new CConnection(start, end, start_anchor, end_anchor, this);
+    AppendConnection(connection);
 
-    return m_connections.last();
+    return connection;
 }
 
 CConnection *CGraphicsScene::AddConnection()
 {
-    m_connections.append(new CConnection(this));
+    CConnection *connection = new CConnection(this);
+    AppendConnection(connection);
 
-    return m_connections.last();
+    return connection;
 }
 
 void CGraphicsScene::AddConnection(CConnection *connection)
 {
-    m_connections.append(connection);
+    AppendConnection(connection);
 
     connection->from()->AddLink(connection);
     connection->to()->AddConnection(connection);
@@ -487,9 +587,22 @@ void CGraphicsScene::RemoveBubble(CBubble *bubble)
 {
     disconnect(bubble, SIGNAL(Selected(QGraphicsItem*)), this, SIGNAL(itemSelected(QGraphicsItem*)));
     disconnect(bubble, SIGNAL(ShapeChanged(QRectF,QRectF)), this, SLOT(ItemShapeChanged(QRectF,QRectF)));
+    disconnect(bubble, SIGNAL(PositionOrShapeChanged()), this, SLOT(ItemGeometryChanged()));
+    disconnect(bubble, SIGNAL(LabelsChanged()), this, SLOT(ItemLabelsChanged()));
 
     removeItem(bubble);
-    m_bubbles.removeAll(bubble);
+    UnindexLabels(bubble);
+
+    if(m_batch > 0)
+    {
+        m_removedBubbles.insert(bubble);
+        BatchChanged();
+    }
+    else
+        m_bubbles.removeAll(bubble);
+
+    if(shared().symbolTable)
+        shared().symbolTable->RemoveBubble(bubble);
 }
 
 void CGraphicsScene::RemoveConnection(CConnection *connection)
@@ -502,7 +615,169 @@ void CGraphicsScene::RemoveConnection(CConnection *connection)
             connection->to()->RemoveConnection(connection);
         removeItem(connection->getLine());
     }
-    m_connections.removeAll(connection);
+
+    if(m_batch > 0)
+        m_removedConnections.insert(connection);
+    else
+        m_connections.removeAll(connection);
+}
+
+void CGraphicsScene::AppendConnection(CConnection *connection)
+{
+    // a connection taken out in the current batch is still listed
+    if(!m_removedConnections.remove(connection))
+        m_connections.append(connection);
+}
+
+/**
+ * @brief Starts a batch of changes, batches nest. Until the outermost one ends
+ *        the scene rect, labelsChanged() and the views are left alone, removals
+ *        are collected and large batches drop the item index.
+ */
+void CGraphicsScene::BeginBatch()
+{
+    if(m_batch++ > 0)
+        return;
+
+    m_batchChanges = 0;
+    for(QGraphicsView *view : views())
+        view->viewport()->setUpdatesEnabled(false);
+}
+
+/**
+ * @brief Applies everything held back since BeginBatch() in a single pass.
+ */
+void CGraphicsScene::EndBatch()
+{
+    if(m_batch == 0 || --m_batch > 0)
+        return;
+
+    ApplyRemovals();
+
+    if(m_indexSuspended)
+    {
+        setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+        m_indexSuspended = false;
+    }
+
+    if(!m_batchRect.isNull())
+    {
+        const QRectF rect = m_batchRect;
+        m_batchRect = QRectF();
+        GrowSceneRect(rect);
+    }
+
+    if(m_labelsChanged)
+    {
+        m_labelsChanged = false;
+        emit labelsChanged();
+    }
+
+    // enabling updates repaints each view once
+    for(QGraphicsView *view : views())
+        view->viewport()->setUpdatesEnabled(true);
+}
+
+void CGraphicsScene::ApplyRemovals()
+{
+    if(!m_removedBubbles.isEmpty())
+    {
+        QList<CBubble *> bubbles;
+        bubbles.reserve(m_bubbles.length());
+        for(CBubble *bubble : m_bubbles)
+            if(!m_removedBubbles.contains(bubble))
+                bubbles.append(bubble);
+
+        m_bubbles = bubbles;
+        m_removedBubbles.clear();
+    }
+
+    if(!m_removedConnections.isEmpty())
+    {
+        QList<CConnection *> connections;
+        connections.reserve(m_connections.length());
+        for(CConnection *connection : m_connections)
+            if(!m_removedConnections.contains(connection))
+                connections.append(connection);
+
+        m_connections = connections;
+        m_removedConnections.clear();
+    }
+}
+
+// Rebuilding the index once is cheaper than updating it for every item of a large batch
+void CGraphicsScene::BatchChanged()
+{
+    if(++m_batchChanges == BatchIndexThreshold && itemIndexMethod() == QGraphicsScene::BspTreeIndex)
+    {
+        setItemIndexMethod(QGraphicsScene::NoIndex);
+        m_indexSuspended = true;
+    }
+}
+
+CGraphicsScene::Batch::Batch(CGraphicsScene *scene)
+    : m_scene(scene)
+{
+    if(m_scene)
+        m_scene->BeginBatch();
+}
+
+CGraphicsScene::Batch::~Batch()
+{
+    if(m_scene)
+        m_scene->EndBatch();
+}
+
+QStringList CGraphicsScene::labels() const
+{
+    return m_labels.keys();
+}
+
+void CGraphicsScene::IndexLabels(CBubble *bubble)
+{
+    const QStringList lst = bubble->labels();
+    if(lst.isEmpty())
+        return;
+
+    m_bubbleLabels.insert(bubble, lst);
+    for(const QString &label : lst)
+        ++m_labels[label];
+
+    NotifyLabelsChanged();
+}
+
+void CGraphicsScene::UnindexLabels(CBubble *bubble)
+{
+    const QStringList lst = m_bubbleLabels.take(bubble);
+    if(lst.isEmpty())
+        return;
+
+    for(const QString &label : lst)
+    {
+        QMap<QString, int>::iterator it = m_labels.find(label);
+        if(it != m_labels.end() && --it.value() <= 0)
+            m_labels.erase(it);
+    }
+
+    NotifyLabelsChanged();
+}
+
+void CGraphicsScene::NotifyLabelsChanged()
+{
+    if(m_batch > 0)
+        m_labelsChanged = true;
+    else
+        emit labelsChanged();
+}
+
+void CGraphicsScene::ItemLabelsChanged()
+{
+    CBubble *bubble = qobject_cast<CBubble *>(sender());
+    if(bubble && bubble->labels() != m_bubbleLabels.value(bubble))
+    {
+        UnindexLabels(bubble);
+        IndexLabels(bubble);
+    }
 }
 
 CStartBubble *CGraphicsScene::startBubble()
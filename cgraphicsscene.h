@@ -42,6 +42,9 @@
 #define CGRAPHICSSCENE_H
 
 #include <QGraphicsScene>
+#include <QMap>
+#include <QHash>
+#include <QSet>
 #include "Misc/cserializable.h"
 
 QT_BEGIN_NAMESPACE
@@ -84,6 +87,7 @@ public:
 
     bool isRubberBandSelecting() const { return m_rubberBand; }
 
+    CBubble *CreateBubble(BubbleType type, const QPointF &pos);
     CBubble *AddBubble(BubbleType type, const QPointF &pos, bool shift);
     void AddBubble(CBubble *bubble);
     CConnection *AddConnection(CBubble *start, CBubble *end, Chronicler::Anchor start_anchor, Chronicler::Anchor end_anchor);
@@ -97,8 +101,31 @@ public:
     QList<CBubble *> bubbles();
     QList<CConnection *> connections();
 
+    /// @brief bounds of the bubbles, grown as they move and recomputed by UpdateSceneRect()
+    QRectF bubblesRect() const { return m_bubblesRect; }
+
+    QStringList labels() const;
+
     CBubble *BubbleAt(const QPointF &point, bool choiceAllowed = false);
 
+    static QHash<t_uid, CBubble *> BubblesByUID(const QList<CBubble *> &bubbles);
+
+    void BeginBatch();
+    void EndBatch();
+
+    /**
+     * @brief Keeps the scene in a batch for as long as it is alive.
+     */
+    class Batch
+    {
+    public:
+        explicit Batch(CGraphicsScene *scene);
+        ~Batch();
+
+    private:
+        CGraphicsScene *m_scene;
+    };
+
     virtual QDataStream & Serialize(QDataStream &ds) const Q_DECL_OVERRIDE;
     virtual QDataStream & Deserialize(QDataStream &ds, const CVersion &version) Q_DECL_OVERRIDE;
 
@@ -111,6 +138,16 @@ protected:
     virtual void contextMenuEvent(QGraphicsSceneContextMenuEvent *event) Q_DECL_OVERRIDE;
 
 private:
+    void GrowSceneRect(const QRectF &rect);
+
+    void IndexLabels(CBubble *bubble);
+    void UnindexLabels(CBubble *bubble);
+    void NotifyLabelsChanged();
+
+    void AppendConnection(CConnection *connection);
+    void ApplyRemovals();
+    void BatchChanged();
+
     QString m_name;
     QPointF m_startPoint;
     CLine *m_line;
@@ -125,12 +162,29 @@ private:
 
     QList<QPointF> m_oldPositions;
 
+    QRectF m_bubblesRect;
+
+    // every label of the scene with the number of times it is defined, kept up to date by the bubbles
+    QMap<QString, int> m_labels;
+    QHash<CBubble *, QStringList> m_bubbleLabels;
+
+    // changes made during a batch, applied once the outermost batch ends
+    static const int BatchIndexThreshold = 64;
+    int m_batch;
+    int m_batchChanges;
+    bool m_indexSuspended;
+    bool m_labelsChanged;
+    QRectF m_batchRect;
+    QSet<CBubble *> m_removedBubbles;
+    QSet<CConnection *> m_removedConnections;
+
 signals:
     void itemInserted(CBubble *item);
     void itemSelected(QGraphicsItem *item);
     void leftPressed();
     void leftReleased();
     void nameChanged();
+    void labelsChanged();
 
 public slots:
     void SelectAll();
@@ -140,6 +194,8 @@ private slots:
     void ItemSelected(QGraphicsItem *selectedItem);
 //    void ItemPositionChanged(const QPointF &oldPos, const QPointF &newPos);
     void ItemShapeChanged(const QRectF &oldSize, const QRectF &newSize);
+    void ItemGeometryChanged();
+    void ItemLabelsChanged();
 
     void UpdateSceneRect();
 };
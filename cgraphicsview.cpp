@@ -7,19 +7,33 @@
 #include <QtMath>
 #include <QtGlobal>
 #include <QAction>
+#include <QOpenGLWidget>
+#include <QSurfaceFormat>
 
 #include "cgraphicsscene.h"
 #include "Bubbles/cstartbubble.h"
+#include "csettingsview.h"
+
+#include "Misc/chronicler.h"
+using Chronicler::shared;
 
 
 CGraphicsView::CGraphicsView(CGraphicsScene *scene, QWidget *parent)
-    : QGraphicsView(scene, parent), m_scene(scene), m_scale(1.0), m_minScale(0.05), m_maxScale(5.0),
+    : QGraphicsView(scene, parent), m_scene(scene), m_openGL(false), m_scale(1.0), m_minScale(0.05), m_maxScale(5.0),
       m_modifiers(Qt::NoModifier), m_zoom_factor_base(1.0015)
 {
     setMouseTracking(true);
     setDragMode(ScrollHandDrag);
     setRenderHint(QPainter::Antialiasing, true);
 
+    // every item sets up its own pen and brush and pads its bounds
+    setOptimizationFlags(DontSavePainterState | DontAdjustForAntialiasing);
+    setCacheMode(CacheBackground);
+    setViewportUpdateMode(MinimalViewportUpdate);
+
+    if(shared().settingsView)
+        setOpenGL(shared().settingsView->openGL());
+
     QAction *selectAllAction = new QAction(this);
     selectAllAction->setShortcut(QKeySequence::SelectAll);
     connect(selectAllAction, SIGNAL(triggered()), scene, SLOT(SelectAll()));
@@ -46,6 +60,31 @@ CGraphicsScene *CGraphicsView::cScene()
     return m_scene;
 }
 
+void CGraphicsView::setOpenGL(bool enabled)
+{
+    if(enabled == m_openGL)
+        return;
+
+    m_openGL = enabled;
+
+    if(m_openGL)
+    {
+        QOpenGLWidget *gl = new QOpenGLWidget();
+        QSurfaceFormat format;
+        format.setSamples(4);
+        gl->setFormat(format);
+        setViewport(gl);
+
+        // the whole frame is redrawn anyway, so don't bother tracking dirty regions
+        setViewportUpdateMode(FullViewportUpdate);
+    }
+    else
+    {
+        setViewport(new QWidget());
+        setViewportUpdateMode(MinimalViewportUpdate);
+    }
+}
+
 void CGraphicsView::mouseMoveEvent(QMouseEvent *evt)
 {
     QPointF delta = target_viewport_pos - evt->pos();
@@ -16,6 +16,9 @@ public:
 
     CGraphicsScene *cScene();
 
+    bool openGL() const { return m_openGL; }
+    void setOpenGL(bool enabled);
+
 protected:
     virtual void mouseMoveEvent(QMouseEvent *);
     virtual void wheelEvent(QWheelEvent *);
@@ -25,6 +28,8 @@ private:
 
     CGraphicsScene *m_scene;
 
+    bool m_openGL;
+
     double m_scale;
     double m_minScale;
     double m_maxScale;
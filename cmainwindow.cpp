@@ -18,12 +18,17 @@
 #include "Bubbles/cstartbubble.h"
 #include "Bubbles/cstartherebubble.h"
 #include "cgraphicsview.h"
+#include "cminimap.h"
 #include "chomepage.h"
 #include "Properties/cdockmanager.h"
 #include "csettingsview.h"
 #include "Properties/cprojectview.h"
 #include "Connections/cconnection.h"
 #include "Misc/History/cremovebubblescommand.h"
+#include "Misc/History/chistorycommand.h"
+#include "Misc/History/caddbubblescommand.h"
+#include "Misc/cserializable.h"
+#include "Misc/Variables/csymboltable.h"
 
 #include "Properties/cpalettecreator.h"
 #include "Misc/Palette/cpalettebutton.h"
@@ -32,6 +37,8 @@
 #include "Misc/chronicler.h"
 using Chronicler::shared;
 
+static const char *ClipMimeType = "application/x-chronicler-clip";
+
 
 CMainWindow::CMainWindow(QSettings *settings, const QString &filename)
 {
@@ -44,6 +51,7 @@ CMainWindow::CMainWindow(QSettings *settings, const QString &filename)
     setStatusBar(shared().statusBar);
 
     shared().history = new QUndoStack(this);
+    shared().symbolTable = new CSymbolTable(this);
 
     // Load the settings...
     shared().settingsView = new CSettingsView(settings);
@@ -51,6 +59,9 @@ CMainWindow::CMainWindow(QSettings *settings, const QString &filename)
             this, SLOT(SettingsChanged()));
     SettingsChanged();
 
+    connect(shared().history, SIGNAL(indexChanged(int)),
+            this, SLOT(CompactHistory()));
+
     CreateActions();
     CreateMenus();
 
@@ -58,6 +69,7 @@ CMainWindow::CMainWindow(QSettings *settings, const QString &filename)
     shared().sceneTabs->setMovable(true);
     shared().sceneTabs->setTabsClosable(true);
     connect(shared().sceneTabs, SIGNAL(tabCloseRequested(int)), this, SLOT(TabClosed(int)));
+    connect(shared().sceneTabs, SIGNAL(currentChanged(int)), this, SLOT(TabChanged(int)));
 
     shared().homepage = new CHomepage(this);
     shared().sceneTabs->addTab(shared().homepage, tr("Homepage"));
@@ -80,6 +92,14 @@ CMainWindow::CMainWindow(QSettings *settings, const QString &filename)
                                                                                                        static_cast<int>(Qt::LeftDockWidgetArea)).toInt());
     addDockWidget(area, shared().dock);
 
+    // overview of the current scene
+    shared().minimapDock = new QDockWidget(tr("Overview"), this);
+    shared().minimap = new CMinimap(shared().minimapDock);
+    shared().minimapDock->setWidget(shared().minimap);
+    shared().minimapDock->setVisible(false);
+    shared().minimapDock->setAllowedAreas(Qt::LeftDockWidgetArea | Qt::RightDockWidgetArea);
+    addDockWidget(area, shared().minimapDock);
+
     // to allow .chron files to be opened with Chronicler
     if(filename.length())
         shared().projectView->OpenProject(filename);
@@ -108,95 +128,113 @@ void CMainWindow::DeleteSelectedItems()
     }
 }
 
+void CMainWindow::CompactHistory()
+{
+    CHistoryCommand::Compact(static_cast<qint64>(shared().settingsView->undoMemory()) * 1024 * 1024);
+}
+
 void CMainWindow::CopySelectedItems()
 {
     CGraphicsView *view = dynamic_cast<CGraphicsView *>(shared().sceneTabs->currentWidget());
 
     if(view)
     {
-        // deselect start bubble
-        bool start_selected = view->cScene()->startBubble()->isSelected();
-        view->cScene()->startBubble()->setSelected(false);
-
-        if(view->cScene()->selectedItems().length())
+        QList<CBubble *> bubbles;
+        for(QGraphicsItem *item : view->cScene()->selectedItems())
         {
-            QMimeData *data = new QMimeData();
-            QByteArray ba;
-            QDataStream ds(&ba, QIODevice::WriteOnly);
-            QPointF topLeft = view->cScene()->selectedItems().first()->pos();
+            CBubble *bubble = dynamic_cast<CBubble *>(item);
+            if(bubble && bubble->getType() != Chronicler::StartBubble)
+                bubbles.append(bubble);
+        }
 
-            // serialize bubbles & calculate top left
-            ds << static_cast<qint32>(view->cScene()->selectedItems().length());
-            for(QGraphicsItem *item : view->cScene()->selectedItems())
+        if(bubbles.length())
+        {
+            QPointF topLeft = bubbles.first()->pos();
+            for(CBubble *bubble : bubbles)
             {
-                CBubble *bubble = dynamic_cast<CBubble *>(item);
-                if(bubble)
-                {
-                    ds << *bubble;
-
-                    if(bubble->pos().x() < topLeft.x() && bubble->pos().y() < topLeft.y())
-                        topLeft = bubble->pos();
-                }
+                topLeft.setX(qMin(topLeft.x(), bubble->pos().x()));
+                topLeft.setY(qMin(topLeft.y(), bubble->pos().y()));
             }
-            ds << topLeft;
 
-            // copy to clipboard
-            data->setData("application/clip-bubbles", ba);
+            // version & top left first, so pasting can place bubbles as they are read.
+            // links are serialized with their bubbles, the ones leaving the copied bubbles are dropped on paste
+            QByteArray ba;
+            QDataStream ds(&ba, QIODevice::WriteOnly);
+            ds << shared().ProgramVersion << topLeft << static_cast<qint32>(bubbles.length());
+            for(CBubble *bubble : bubbles)
+                ds << *bubble;
+
+            QMimeData *data = new QMimeData();
+            data->setData(ClipMimeType, ba);
             QApplication::clipboard()->setMimeData(data);
         }
-
-        view->cScene()->startBubble()->setSelected(start_selected);
     }
 }
 
 void CMainWindow::PasteItems()
 {
     CGraphicsView *view = dynamic_cast<CGraphicsView *>(shared().sceneTabs->currentWidget());
+    const QMimeData *data = QApplication::clipboard()->mimeData();
 
-    if(view)
+    if(view && data)
     {
-        QDataStream ds(QApplication::clipboard()->mimeData()->data("application/clip-bubbles"));
+        CGraphicsScene *scene = view->cScene();
+        const QByteArray ba = data->data(ClipMimeType);
+        QDataStream ds(ba);
 
-        if(!ds.atEnd())
-        {
-            qint32 len, bubble_type;
-            CBubble *bbl;
+        CVersion version("");
+        QPointF oldPoint;
+        qint32 len = 0;
+        ds >> version >> oldPoint >> len;
 
-            // deselect all
-            for(QGraphicsItem *item : view->cScene()->selectedItems())
-                item->setSelected(false);
+        if(len <= 0)
+            return;
 
-            // deserialize bubbles
-            ds >> len;
-            for(int i = 0; i < len; ++i)
-            {
-                ds >> bubble_type;
-                bbl = view->cScene()->AddBubble(Chronicler::BubbleType(bubble_type), QPointF(), false);
-                bbl->setSelected(true);
-                ds >> *bbl;
-            }
+        // read the bubbles in the version that copied them, not the one of the open project
+        CSerializable::VersionOverride clipVersion(version);
 
-            // calculate & move items to new offset
-            QPointF newPoint = view->mapToScene(view->mapFromGlobal(QCursor::pos()));
-            QPointF oldPoint;
-            ds >> oldPoint;
-            int diffx = newPoint.x() - oldPoint.x();
-            int diffy = newPoint.y() - oldPoint.y();
+        const QPointF newPoint = view->mapToScene(view->mapFromGlobal(QCursor::pos()));
+        const QPointF offset(int(newPoint.x() - oldPoint.x()), int(newPoint.y() - oldPoint.y()));
 
-            for(QGraphicsItem *item : view->cScene()->selectedItems())
-                item->moveBy(diffx, diffy);
+        scene->clearSelection();
 
-            // hook up deserialized connections (more efficient if done after move)
-            for(CConnection *connection : view->cScene()->connections())
-                if(!connection->isConnected())
-                    connection->ConnectToUIDs(true);
+        // bulk add, the connections read with the bubbles are appended to the scene
+        CGraphicsScene::Batch batch(scene);
+        const int firstConnection = scene->connections().length();
+        QList<CBubble *> bubbles;
+        bubbles.reserve(len);
 
-            for(QGraphicsItem *item : view->cScene()->selectedItems())
-            {
-                if((bbl = dynamic_cast<CBubble *>(item)))
-                    bbl->UpdateUID();
-            }
+        for(int i = 0; i < len && !ds.atEnd(); ++i)
+        {
+            qint32 bubble_type;
+            ds >> bubble_type;
+
+            CBubble *bbl = scene->CreateBubble(Chronicler::BubbleType(bubble_type), QPointF());
+            if(!bbl)
+                break;
+
+            scene->AddBubble(bbl);
+            ds >> *bbl;
+            bbl->moveBy(offset.x(), offset.y());
+            bubbles.append(bbl);
+        }
+
+        // hook up the connections between the pasted bubbles through the UIDs they were copied with,
+        // never through the live bubbles, which may belong to another scene, project or instance
+        const QHash<t_uid, CBubble *> uids = CGraphicsScene::BubblesByUID(bubbles);
+        const QList<CConnection *> connections = scene->connections().mid(firstConnection);
+        for(CConnection *connection : connections)
+            if(!connection->isConnected())
+                connection->ConnectToUIDs(uids);
+
+        // fresh UIDs, the copied ones still belong to the originals
+        for(CBubble *bbl : bubbles)
+        {
+            bbl->UpdateUID();
+            bbl->setSelected(true);
         }
+
+        shared().history->push(new CAddBubblesCommand(scene, bubbles, true));
     }
 }
 
@@ -257,6 +295,11 @@ void CMainWindow::ShowDock()
     shared().dock->setVisible(!shared().dock->isVisible());
 }
 
+void CMainWindow::ShowMinimap()
+{
+    shared().minimapDock->setVisible(!shared().minimapDock->isVisible());
+}
+
 void CMainWindow::ShowForum()
 {
     QDesktopServices::openUrl(QUrl("https://forum.choiceofgames.com/t/tool-chronicler-choicescript-visual-code-editor/6811"));
@@ -292,6 +335,12 @@ void CMainWindow::TabClosed(int index)
     shared().sceneTabs->removeTab(index);
 }
 
+void CMainWindow::TabChanged(int index)
+{
+    if(shared().minimap)
+        shared().minimap->setView(dynamic_cast<CGraphicsView *>(shared().sceneTabs->widget(index)));
+}
+
 void CMainWindow::DockAreaChanged(Qt::DockWidgetArea area)
 {
     // reflect this change in the settings.
@@ -409,6 +458,12 @@ void CMainWindow::SettingsChanged()
 
     // Update history
     shared().history->setUndoLimit(shared().settingsView->maxUndos());
+    CompactHistory();
+
+    // Update canvas rendering
+    if(shared().projectView)
+        for(CGraphicsView *view : shared().projectView->getViews())
+            view->setOpenGL(shared().settingsView->openGL());
 }
 
 void CMainWindow::ShowAbout()
@@ -495,6 +550,10 @@ void CMainWindow::CreateActions()
     shared().showDockAction = new QAction(tr("Show &dock"), this);
     connect(shared().showDockAction, SIGNAL(triggered(bool)), this, SLOT(ShowDock()));
 
+    shared().showMinimapAction = new QAction(tr("Show &overview"), this);
+    shared().showMinimapAction->setToolTip(tr("Minimap of the current scene"));
+    connect(shared().showMinimapAction, SIGNAL(triggered(bool)), this, SLOT(ShowMinimap()));
+
     // Tools
     QString testToolTip = tr("Before running, make sure your web directory is clean and the default program for opening .html files is NOT Google Chrome.");
     shared().quickTestAction = new QAction(tr("&Quick test"), this);
@@ -553,6 +612,7 @@ void CMainWindow::CreateMenus()
     shared().viewMenu->setToolTipsVisible(true);
     shared().viewMenu->addAction(shared().showHomepageAction);
     shared().viewMenu->addAction(shared().showDockAction);
+    shared().viewMenu->addAction(shared().showMinimapAction);
 
     shared().toolsMenu = menuBar()->addMenu(tr("&Tools"));
     shared().toolsMenu->setToolTipsVisible(true);
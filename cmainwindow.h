@@ -91,6 +91,7 @@ private slots:
     void ShowSettings();
     void ShowHomepage();
     void ShowDock();
+    void ShowMinimap();
     void ShowForum();
 
     void NewProject();
@@ -104,7 +105,9 @@ private slots:
     void CopySelectedItems();
     void PasteItems();
     void TabClosed(int);
+    void TabChanged(int);
     void SettingsChanged();
+    void CompactHistory();
 
     void DockAreaChanged(Qt::DockWidgetArea);
     void PointerToolBarAreaChanged(bool);
@@ -0,0 +1,197 @@
+#include "cminimap.h"
+
+#include <QPainter>
+#include <QTimer>
+#include <QMouseEvent>
+#include <QScrollBar>
+
+#include "cgraphicsview.h"
+#include "cgraphicsscene.h"
+
+
+CMinimap::CMinimap(QWidget *parent)
+    : QWidget(parent), m_full(true)
+{
+    setMinimumSize(120, 90);
+    setCursor(Qt::PointingHandCursor);
+
+    // collect changes for a moment so dragging bubbles doesn't re-render every frame
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(150);
+    connect(m_timer, SIGNAL(timeout()), this, SLOT(Flush()));
+}
+
+void CMinimap::setView(CGraphicsView *view)
+{
+    if(view == m_view)
+        return;
+
+    if(m_view)
+    {
+        disconnect(m_view->horizontalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(update()));
+        disconnect(m_view->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(update()));
+    }
+    if(m_scene)
+        disconnect(m_scene, SIGNAL(changed(QList<QRectF>)), this, SLOT(SceneChanged(QList<QRectF>)));
+
+    m_view = view;
+    m_scene = view ? view->cScene() : Q_NULLPTR;
+
+    if(m_view)
+    {
+        connect(m_view->horizontalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(update()));
+        connect(m_view->verticalScrollBar(), SIGNAL(valueChanged(int)), this, SLOT(update()));
+    }
+    if(m_scene)
+        connect(m_scene, SIGNAL(changed(QList<QRectF>)), this, SLOT(SceneChanged(QList<QRectF>)));
+
+    m_full = true;
+    Flush();
+}
+
+QSize CMinimap::sizeHint() const
+{
+    return QSize(240, 180);
+}
+
+void CMinimap::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::gray);
+
+    if(!m_view || !m_scene)
+        return;
+
+    painter.drawPixmap(0, 0, m_cache);
+
+    // visible area of the view
+    QRectF visible = m_view->mapToScene(m_view->viewport()->rect()).boundingRect();
+    painter.setPen(QPen(Qt::white, 1));
+    painter.setBrush(QColor(255, 255, 255, 40));
+    painter.drawRect(MapFromScene(visible));
+}
+
+void CMinimap::resizeEvent(QResizeEvent *)
+{
+    // clicks map through the new size right away, the snapshot follows with the timer
+    if(m_scene)
+        UpdateSource();
+
+    m_full = true;
+    m_timer->start();
+}
+
+void CMinimap::showEvent(QShowEvent *)
+{
+    m_full = true;
+    Flush();
+}
+
+void CMinimap::mousePressEvent(QMouseEvent *event)
+{
+    if(m_view && event->button() == Qt::LeftButton)
+        m_view->centerOn(MapToScene(event->pos()));
+}
+
+void CMinimap::mouseMoveEvent(QMouseEvent *event)
+{
+    if(m_view && (event->buttons() & Qt::LeftButton))
+        m_view->centerOn(MapToScene(event->pos()));
+}
+
+void CMinimap::SceneChanged(const QList<QRectF> &region)
+{
+    for(const QRectF &r : region)
+        m_dirty |= r;
+
+    if(!m_dirty.isNull())
+        m_timer->start();
+}
+
+void CMinimap::Flush()
+{
+    m_timer->stop();
+
+    if(!isVisible() || !m_scene)
+        return;
+
+    // anything outside of the cached area requires remapping the whole scene
+    if(m_full || !m_source.contains(m_dirty))
+        RenderAll();
+    else if(!m_dirty.isNull())
+        RenderRegion(m_dirty);
+
+    m_dirty = QRectF();
+    update();
+}
+
+void CMinimap::UpdateSource()
+{
+    // the scene keeps the bounds of its bubbles up to date, no need to walk its items
+    QRectF bounds = m_scene->bubblesRect();
+    if(bounds.isNull())
+        bounds = QRectF(m_scene->sceneRect().center(), QSizeF(1, 1));
+    bounds.adjust(-200, -200, 200, 200);
+
+    if(m_view)
+        bounds |= m_view->mapToScene(m_view->viewport()->rect()).boundingRect();
+
+    // match the aspect ratio of the widget so the mapping is uniform
+    const qreal aspect = qreal(qMax(width(), 1)) / qMax(height(), 1);
+    if(bounds.width() / bounds.height() > aspect)
+    {
+        const qreal h = bounds.width() / aspect;
+        bounds.adjust(0, -(h - bounds.height()) / 2, 0, (h - bounds.height()) / 2);
+    }
+    else
+    {
+        const qreal w = bounds.height() * aspect;
+        bounds.adjust(-(w - bounds.width()) / 2, 0, (w - bounds.width()) / 2, 0);
+    }
+
+    m_source = bounds;
+}
+
+void CMinimap::RenderAll()
+{
+    m_full = false;
+
+    UpdateSource();
+    m_cache = QPixmap(size());
+
+    RenderRegion(m_source);
+}
+
+void CMinimap::RenderRegion(const QRectF &region)
+{
+    if(m_cache.isNull())
+        return;
+
+    QRectF target = MapFromScene(region).adjusted(-1, -1, 1, 1) & QRectF(m_cache.rect());
+    QRectF source(MapToScene(target.topLeft()), MapToScene(target.bottomRight()));
+
+    QPainter painter(&m_cache);
+    painter.setClipRect(target);
+    painter.fillRect(target, m_scene->backgroundBrush());
+    m_scene->render(&painter, target, source, Qt::IgnoreAspectRatio);
+}
+
+QRectF CMinimap::MapFromScene(const QRectF &rect) const
+{
+    if(m_source.isEmpty())
+        return QRectF();
+
+    const qreal s = width() / m_source.width();
+    return QRectF((rect.x() - m_source.x()) * s, (rect.y() - m_source.y()) * s,
+                  rect.width() * s, rect.height() * s);
+}
+
+QPointF CMinimap::MapToScene(const QPointF &point) const
+{
+    if(m_source.isEmpty())
+        return QPointF();
+
+    const qreal s = m_source.width() / qMax(width(), 1);
+    return QPointF(m_source.x() + point.x() * s, m_source.y() + point.y() * s);
+}
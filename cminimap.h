@@ -0,0 +1,63 @@
+#ifndef CMINIMAP_H
+#define CMINIMAP_H
+
+#include <QWidget>
+#include <QPointer>
+#include <QPixmap>
+
+QT_BEGIN_NAMESPACE
+class QTimer;
+QT_END_NAMESPACE
+
+class CGraphicsView;
+class CGraphicsScene;
+
+
+/**
+ * @brief Low resolution overview of a scene.
+ * Keeps a cached snapshot of the scene and only re-renders the regions
+ * that changed. Clicking or dragging centers the attached view.
+ */
+class CMinimap : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit CMinimap(QWidget *parent = 0);
+
+    CGraphicsView *view() const { return m_view; }
+    void setView(CGraphicsView *view);
+
+    virtual QSize sizeHint() const Q_DECL_OVERRIDE;
+
+protected:
+    virtual void paintEvent(QPaintEvent *) Q_DECL_OVERRIDE;
+    virtual void resizeEvent(QResizeEvent *) Q_DECL_OVERRIDE;
+    virtual void showEvent(QShowEvent *) Q_DECL_OVERRIDE;
+    virtual void mousePressEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
+    virtual void mouseMoveEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
+
+private:
+    void UpdateSource();
+    void RenderAll();
+    void RenderRegion(const QRectF &region);
+
+    QRectF MapFromScene(const QRectF &rect) const;
+    QPointF MapToScene(const QPointF &point) const;
+
+    QPointer<CGraphicsView> m_view;
+    QPointer<CGraphicsScene> m_scene;
+
+    QPixmap m_cache;
+    QRectF  m_source;
+    QRectF  m_dirty;
+    bool    m_full;
+
+    QTimer *m_timer;
+
+private slots:
+    void SceneChanged(const QList<QRectF> &region);
+    void Flush();
+};
+
+#endif // CMINIMAP_H
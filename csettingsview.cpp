@@ -71,6 +71,11 @@ QColor CSettingsView::fontColor()
     return m_fontColor;
 }
 
+bool CSettingsView::openGL()
+{
+    return m_openGL->isChecked();
+}
+
 int CSettingsView::maxAutosaves()
 {
     return m_autosaves->value();
@@ -86,6 +91,14 @@ int CSettingsView::maxUndos()
     return m_undos->value();
 }
 
+/**
+ * @brief Megabytes the history may keep alive before old removals are stored compactly.
+ */
+int CSettingsView::undoMemory()
+{
+    return m_undoMemory->value();
+}
+
 bool CSettingsView::storeHistoryInProject()
 {
     return m_history->isChecked();
@@ -166,8 +179,14 @@ void CSettingsView::SetupEditor(QLayout *main_layout)
     hl_font->addWidget(m_fontColorButton);
     hl_font->addStretch(4);
 
+    // Canvas rendering
+    m_openGL = new QCheckBox("hardware accelerated (OpenGL)");
+    connect(m_openGL, SIGNAL(stateChanged(int)),
+            this, SLOT(SettingChanged()));
+
     // Add rows
     fl_editor->addRow("Font", hl_font);
+    fl_editor->addRow("Canvas", m_openGL);
     //    fl_editor->addRow("Theme", new QCheckBox("dark"));
 }
 
@@ -216,6 +235,17 @@ void CSettingsView::SetupHistory(QLayout *main_layout)
     hl_undos->addWidget(m_history, 0, Qt::AlignLeft);
     hl_undos->addStretch(1);
 
+    // Undo memory
+    QHBoxLayout *hl_undo_memory = new QHBoxLayout();
+
+    m_undoMemory = new QSpinBox();
+    m_undoMemory->setRange(1, 1024);
+    connect(m_undoMemory, SIGNAL(valueChanged(int)),
+            this, SLOT(SettingChanged()));
+    hl_undo_memory->addWidget(m_undoMemory, 0, Qt::AlignLeft);
+    hl_undo_memory->addWidget(new QLabel(" MB", this));
+    hl_undo_memory->addStretch(1);
+
     // Max Recent Files
     QHBoxLayout *hl_recent = new QHBoxLayout();
     m_recent_files = new QSpinBox();
@@ -229,6 +259,7 @@ void CSettingsView::SetupHistory(QLayout *main_layout)
     fl_history->addRow("max autosaves", hl_autosaves);
     fl_history->addRow("autosave interval", hl_autosaves_interval);
     fl_history->addRow("max undos", hl_undos);
+    fl_history->addRow("undo memory", hl_undo_memory);
     fl_history->addRow("max recent files", hl_recent);
 }
 
@@ -242,11 +273,13 @@ void CSettingsView::LoadSettings()
     m_fontSize->setValue(font.pointSize());
     m_fontCombo->setCurrentFont(font);
     FontColorSelected(m_settings->value("Editor/FontColor", QVariant::fromValue(QColor(Qt::black))).value<QColor>());
+    m_openGL->setChecked(m_settings->value("Editor/OpenGL", false).toBool());
 
     // Load History
     m_autosaves->setValue(m_settings->value("Editor/MaxAutosaves", 5).toInt());
     m_autosave_interval->setValue(m_settings->value("Editor/AutosaveInterval", 5).toInt());
     m_undos->setValue(m_settings->value("Editor/MaxUndos", 100).toInt());
+    m_undoMemory->setValue(m_settings->value("Editor/UndoMemory", 32).toInt());
     m_history->setCheckState(static_cast<Qt::CheckState>(m_settings->value("Editor/StoreHistory", Qt::Unchecked).toInt()));
     m_recent_files->setValue(m_settings->value("Editor/MaxRecentFiles", 10).toInt());
 }
@@ -259,11 +292,13 @@ void CSettingsView::SaveSettings()
     // Save Editor
     m_settings->setValue("Editor/Font", QVariant::fromValue(font())); // includes point size
     m_settings->setValue("Editor/FontColor", QVariant::fromValue(fontColor()));
+    m_settings->setValue("Editor/OpenGL", openGL());
 
     // Save History
     m_settings->setValue("Editor/MaxAutosaves", maxAutosaves());
     m_settings->setValue("Editor/AutosaveInterval", m_autosave_interval->value());
     m_settings->setValue("Editor/MaxUndos", maxUndos());
+    m_settings->setValue("Editor/UndoMemory", undoMemory());
     m_settings->setValue("Editor/StoreHistory", static_cast<int>(m_history->checkState()));
     m_settings->setValue("Editor/MaxRecentFiles", maxRecentFiles());
 }
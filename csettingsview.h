@@ -29,10 +29,12 @@ public:
 
     QFont font();
     QColor fontColor();
+    bool openGL();
 
     int maxAutosaves();
     int autosaveInterval();
     int maxUndos();
+    int undoMemory();
     bool storeHistoryInProject();
     int maxRecentFiles();
 
@@ -66,10 +68,12 @@ private:
     QPushButton     *m_fontColorButton;
     QFont            m_font;
     QColor           m_fontColor;
+    QCheckBox       *m_openGL;
 
     QSpinBox        *m_autosaves;
     QSpinBox        *m_autosave_interval;
     QSpinBox        *m_undos;
+    QSpinBox        *m_undoMemory;
     QCheckBox       *m_history;
     QSpinBox        *m_recent_files;
 
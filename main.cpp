@@ -3,6 +3,7 @@
 #include <QTranslator>
 
 #include "cmainwindow.h"
+#include "Misc/cdictionary.h"
 
 int main(int argv, char *args[])
 {
@@ -10,6 +11,9 @@ int main(int argv, char *args[])
 
     QApplication app(argv, args);
 
+    // load the spell checking dictionary while the main window is set up
+    CDictionary::Preload(CDictionary::defaultPath());
+
     QSettings settings(QSettings::IniFormat, QSettings::UserScope, "Chronicler-Next", "Chronicler");
     QRect windowRect = settings.value("MainWindow/Geometry", QRect(100, 100, 1280, 720)).value<QRect>();
 